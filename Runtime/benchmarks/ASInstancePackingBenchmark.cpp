@@ -0,0 +1,90 @@
+#include <RHINO.h>
+
+#include <CLI11.hpp>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include "Utils/ASInstancePacking.h"
+
+// Measures TLAS instance packing to write combined like destination without GPU.
+// Build with RHINO_ENABLE_AVX2 to measure AVX2 path.
+
+using Clock = std::chrono::steady_clock;
+
+static double ToMilliseconds(Clock::duration duration) noexcept {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+// Moves every step-th instance, so only they differ from previously packed records.
+static void MoveInstances(std::vector<RHINO::BLASInstanceDesc>& instances, size_t step, float offset) noexcept {
+    for (size_t i = 0; i < instances.size(); i += step) {
+        instances[i].transform[0][3] += offset;
+    }
+}
+
+static double MeasurePacking(const std::vector<RHINO::BLASInstanceDesc>& instances, RHINO::PackedASInstance* shadow,
+                             RHINO::PackedASInstance* dst) noexcept {
+    const auto start = Clock::now();
+    RHINO::PackASInstances(instances.data(), instances.size(), shadow, dst,
+                           [](RHINO::BLAS* blas) { return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(blas)); });
+    return ToMilliseconds(Clock::now() - start);
+}
+
+int main(int argc, char* argv[]) {
+    size_t instancesCount = 100'000;
+    size_t iterations = 100;
+    size_t changedStep = 100;
+
+    CLI::App app{"RHINO TLAS instance packing benchmark. Measures full, unchanged and partially changed instance writes.",
+                 "ASInstancePackingBenchmark"};
+    try {
+        app.add_option("-n,--instances", instancesCount, "Instances count.")->check(CLI::PositiveNumber);
+        app.add_option("-i,--iterations", iterations, "Packing runs count per case.")->check(CLI::PositiveNumber);
+        app.add_option("-s,--step", changedStep, "Every step-th instance changes in partial case.")->check(CLI::PositiveNumber);
+        app.parse(argc, argv);
+    }
+    catch (std::exception& error) {
+        std::cerr << "ASInstancePackingBenchmark CLI usage error:\n" << error.what() << std::endl;
+        return 1;
+    }
+
+    std::vector<RHINO::BLASInstanceDesc> instances(instancesCount);
+    for (size_t i = 0; i < instancesCount; ++i) {
+        // Fake BLAS addresses, packing only stores them.
+        instances[i].blas = reinterpret_cast<RHINO::BLAS*>(0x10000 + i * 0x100);
+        instances[i].instanceID = static_cast<uint32_t>(i);
+        instances[i].transform[0][3] = static_cast<float>(i);
+    }
+
+    // Destination must be 32 bytes aligned for streaming stores.
+    constexpr std::align_val_t DST_ALIGNMENT{64};
+    auto* dst = static_cast<RHINO::PackedASInstance*>(::operator new(instancesCount * sizeof(RHINO::PackedASInstance), DST_ALIGNMENT));
+    std::vector<RHINO::PackedASInstance> shadow(instancesCount);
+
+    double full = 0.0;
+    double unchanged = 0.0;
+    double partial = 0.0;
+    for (size_t i = 0; i < iterations; ++i) {
+        // Same as a freshly created instance buffer.
+        memset(shadow.data(), 0xFF, shadow.size() * sizeof(RHINO::PackedASInstance));
+        full += MeasurePacking(instances, shadow.data(), dst);
+        unchanged += MeasurePacking(instances, shadow.data(), dst);
+        MoveInstances(instances, changedStep, 1.0f);
+        partial += MeasurePacking(instances, shadow.data(), dst);
+    }
+    ::operator delete(dst, DST_ALIGNMENT);
+
+    std::cout << "Instances: " << instancesCount << ", iterations: " << iterations << std::endl;
+    std::cout << "  Full write: " << full / iterations << " ms" << std::endl;
+    std::cout << "  Unchanged: " << unchanged / iterations << " ms" << std::endl;
+    std::cout << "  Every " << changedStep << "th changed: " << partial / iterations << " ms" << std::endl;
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include <RHINO.h>
+
+#include <CLI11.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Measures host semaphore wait wake up latency for different InitializeDesc::hostWaitSpinTimeInMicroseconds.
+// Semaphore is signaled from host thread after job delay, emulating short GPU job completion.
+// Latency is time from signal to return from wait.
+
+using Clock = std::chrono::steady_clock;
+
+struct LatencyStats {
+    double median = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+    size_t timeouts = 0;
+};
+
+static double ToMicroseconds(Clock::duration duration) noexcept {
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+static LatencyStats MeasureWaits(RHINO::BackendAPI backend, size_t spinTimeInMicroseconds, size_t jobDelayInMicroseconds,
+                                 size_t iterations, bool waitAny) noexcept {
+    RHINO::RHINOInterface* rhi = RHINO::CreateRHINO(backend);
+    RHINO::InitializeDesc initDesc{};
+    initDesc.hostWaitSpinTimeInMicroseconds = spinTimeInMicroseconds;
+    rhi->Initialize(initDesc);
+
+    RHINO::Semaphore* semaphore = rhi->CreateSyncSemaphore(0);
+    // Never signaled, makes SemaphoresWaitFromHost wait for any of two.
+    RHINO::Semaphore* idleSemaphore = rhi->CreateSyncSemaphore(0);
+
+    std::atomic<uint64_t> waitingForValue = 0;
+    std::vector<Clock::time_point> signalTimes(iterations);
+    std::thread signaler{[&]() {
+        for (size_t i = 0; i < iterations; ++i) {
+            const uint64_t value = i + 1;
+            while (waitingForValue.load(std::memory_order_acquire) != value) {
+                std::this_thread::yield();
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(jobDelayInMicroseconds));
+            signalTimes[i] = Clock::now();
+            rhi->SignalFromHost(semaphore, value);
+        }
+    }};
+
+    constexpr size_t TIMEOUT_IN_NANOSECONDS = 1'000'000'000;
+    LatencyStats result{};
+    std::vector<double> latencies(iterations);
+    for (size_t i = 0; i < iterations; ++i) {
+        const uint64_t value = i + 1;
+        waitingForValue.store(value, std::memory_order_release);
+        bool reached = false;
+        if (waitAny) {
+            const RHINO::SemaphoreWaitDesc waits[] = {{semaphore, value}, {idleSemaphore, 1}};
+            reached = rhi->SemaphoresWaitFromHost(2, waits, false, TIMEOUT_IN_NANOSECONDS);
+        }
+        else {
+            reached = rhi->SemaphoreWaitFromHost(semaphore, value, TIMEOUT_IN_NANOSECONDS);
+        }
+        const Clock::time_point wakeTime = Clock::now();
+        if (!reached) {
+            ++result.timeouts;
+            // Signaler may still be about to signal, let it finish before next iteration.
+            rhi->SemaphoreWaitFromHost(semaphore, value, ~0ull);
+        }
+        // Signal time is written before signal, wait is synchronized with it.
+        latencies[i] = std::max(ToMicroseconds(wakeTime - signalTimes[i]), 0.0);
+    }
+    signaler.join();
+
+    std::sort(latencies.begin(), latencies.end());
+    result.median = latencies[latencies.size() / 2];
+    result.p99 = latencies[std::min(latencies.size() - 1, latencies.size() * 99 / 100)];
+    result.max = latencies.back();
+
+    idleSemaphore->Release();
+    semaphore->Release();
+    rhi->Release();
+    delete rhi;
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    std::string backendName = "vulkan";
+    std::vector<size_t> spinTimes = {0, 20, 100, 500};
+    size_t jobDelay = 100;
+    size_t iterations = 1000;
+    bool waitAny = false;
+
+    CLI::App app{"RHINO host wait latency benchmark. Compares spin then block semaphore waits for different spin times.",
+                 "HostWaitLatencyBenchmark"};
+    try {
+        app.add_option("-b,--backend", backendName, "Backend API.")->check(CLI::IsMember({"vulkan", "d3d12"}));
+        app.add_option("-s,--spin", spinTimes, "Host wait spin times in microseconds.");
+        app.add_option("-d,--delay", jobDelay, "Emulated job duration before signal in microseconds.");
+        app.add_option("-i,--iterations", iterations, "Waits count per spin time.")->check(CLI::PositiveNumber);
+        app.add_flag("-a,--any", waitAny, "Wait with SemaphoresWaitFromHost for any of two semaphores.");
+        app.parse(argc, argv);
+    }
+    catch (std::exception& error) {
+        std::cerr << "HostWaitLatencyBenchmark CLI usage error:\n" << error.what() << std::endl;
+        return 1;
+    }
+
+    const RHINO::BackendAPI backend = backendName == "d3d12" ? RHINO::BackendAPI::D3D12 : RHINO::BackendAPI::Vulkan;
+    std::cout << "Job delay: " << jobDelay << " us, iterations: " << iterations << std::endl;
+    for (size_t spinTime : spinTimes) {
+        const LatencyStats stats = MeasureWaits(backend, spinTime, jobDelay, iterations, waitAny);
+        std::cout << "Spin " << spinTime << " us: median " << stats.median << " us, p99 " << stats.p99 << " us, max " << stats.max << " us";
+        if (stats.timeouts) {
+            std::cout << ", timeouts " << stats.timeouts;
+        }
+        std::cout << std::endl;
+    }
+    return 0;
+}
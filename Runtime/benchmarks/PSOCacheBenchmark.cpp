@@ -0,0 +1,129 @@
+#include <RHINO.h>
+
+#include <CLI11.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Measures startup PSO compilation with empty (cold) and populated (warm) PSO cache.
+// Driver side shader caches hide the difference, disable them for the run,
+// e.g. MESA_SHADER_CACHE_DISABLE=true or __GL_SHADER_DISK_CACHE=0.
+
+using Clock = std::chrono::steady_clock;
+
+static bool ReadArchive(const std::filesystem::path& filepath, std::vector<uint8_t>& archive) noexcept {
+    std::ifstream inFile{filepath, std::ifstream::binary | std::ifstream::ate};
+    if (!inFile.is_open()) {
+        return false;
+    }
+    std::streamsize size = inFile.tellg();
+    inFile.seekg(0, std::ifstream::beg);
+    archive.resize(size);
+    return size && inFile.read(reinterpret_cast<char*>(archive.data()), size);
+}
+
+static double ToMilliseconds(Clock::duration duration) noexcept {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+struct StartupTimings {
+    double initialize = 0.0;
+    double compilation = 0.0;
+    size_t failedPSOs = 0;
+};
+
+static StartupTimings RunStartup(const std::string& cachePath, const std::vector<std::vector<uint8_t>>& archives,
+                                 size_t descriptorsCount) noexcept {
+    StartupTimings result{};
+
+    const auto initStart = Clock::now();
+    RHINO::RHINOInterface* rhi = RHINO::CreateRHINO(RHINO::BackendAPI::Vulkan);
+    RHINO::InitializeDesc initDesc{};
+    initDesc.psoCachePath = cachePath.c_str();
+    rhi->Initialize(initDesc);
+    result.initialize = ToMilliseconds(Clock::now() - initStart);
+
+    RHINO::DescriptorRangeDesc range{RHINO::DescriptorRangeType::CBV, 0, descriptorsCount};
+    RHINO::DescriptorSpaceDesc space{};
+    space.rangeDescCount = 1;
+    space.rangeDescs = &range;
+    RHINO::RootSignatureDesc rootSignatureDesc{};
+    rootSignatureDesc.spacesCount = 1;
+    rootSignatureDesc.spacesDescs = &space;
+    rootSignatureDesc.debugName = "PSOCacheBenchmarkRootSignature";
+    RHINO::RootSignature* rootSignature = rhi->SerializeRootSignature(rootSignatureDesc);
+
+    std::vector<RHINO::ComputePSO*> psos{};
+    const auto compilationStart = Clock::now();
+    for (const std::vector<uint8_t>& archive : archives) {
+        psos.push_back(rhi->CompileSCARComputePSO(archive.data(), static_cast<uint32_t>(archive.size()), rootSignature,
+                                                  "PSOCacheBenchmarkPSO"));
+    }
+    result.compilation = ToMilliseconds(Clock::now() - compilationStart);
+
+    for (RHINO::ComputePSO* pso : psos) {
+        if (pso) {
+            pso->Release();
+        }
+        else {
+            ++result.failedPSOs;
+        }
+    }
+    rhi->SavePSOCache();
+    rootSignature->Release();
+    rhi->Release();
+    delete rhi;
+    return result;
+}
+
+static void PrintTimings(const char* name, const StartupTimings& timings) noexcept {
+    std::cout << name << ": initialize " << timings.initialize << " ms, compilation " << timings.compilation << " ms";
+    if (timings.failedPSOs) {
+        std::cout << ", failed PSOs " << timings.failedPSOs;
+    }
+    std::cout << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::filesystem::path> archiveFilepaths;
+    std::string cachePath = "PSOCacheBenchmark.cache";
+    size_t descriptorsCount = 64;
+    size_t iterations = 3;
+
+    CLI::App app{"RHINO PSO cache benchmark. Compares Vulkan startup PSO compilation with cold and warm PSO cache.",
+                 "PSOCacheBenchmark"};
+    try {
+        app.add_option("filepaths", archiveFilepaths, "SCAR compute archive filepaths")->required();
+        app.add_option("-c,--cache", cachePath, "PSO cache filepath. Deleted before every cold run.");
+        app.add_option("-d,--descriptors", descriptorsCount, "Descriptors count of the single SRV_CBV_UAV root signature space.");
+        app.add_option("-i,--iterations", iterations, "Cold and warm runs count.");
+        app.parse(argc, argv);
+    }
+    catch (std::exception& error) {
+        std::cerr << "PSOCacheBenchmark CLI usage error:\n" << error.what() << std::endl;
+        return 1;
+    }
+
+    std::vector<std::vector<uint8_t>> archives(archiveFilepaths.size());
+    for (size_t i = 0; i < archiveFilepaths.size(); ++i) {
+        if (!ReadArchive(archiveFilepaths[i], archives[i])) {
+            std::cerr << "Failed to read file: " << archiveFilepaths[i] << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "PSOs per startup: " << archives.size() << std::endl;
+    for (size_t i = 0; i < iterations; ++i) {
+        std::filesystem::remove(cachePath);
+        const StartupTimings cold = RunStartup(cachePath, archives, descriptorsCount);
+        const StartupTimings warm = RunStartup(cachePath, archives, descriptorsCount);
+        std::cout << "Iteration " << i << std::endl;
+        PrintTimings("  Cold", cold);
+        PrintTimings("  Warm", warm);
+    }
+    std::filesystem::remove(cachePath);
+    return 0;
+}
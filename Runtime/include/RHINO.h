@@ -17,7 +17,8 @@ namespace RHINO {
         virtual ~RHINOInterface() noexcept = default;
 
     public:
-        virtual void Initialize() noexcept = 0;
+        void Initialize() noexcept { Initialize(InitializeDesc{}); }
+        virtual void Initialize(const InitializeDesc& desc) noexcept = 0;
         virtual void Release() noexcept = 0;
 
     public:
@@ -26,9 +27,23 @@ namespace RHINO {
 
         virtual RTPSO* CreateRTPSO(const RTPSODesc& desc) noexcept = 0;
         virtual RTPSO* CreateSCARRTPSO(const void* scar, uint32_t sizeInBytes, const RTPSODesc& desc) noexcept = 0;
+        // Returns nullptr if PSO failed to compile.
         virtual ComputePSO* CompileComputePSO(const ComputePSODesc& desc) noexcept = 0;
         virtual ComputePSO* CompileSCARComputePSO(const void* scar, uint32_t sizeInBytes, RootSignature* rootSignature,
-                                                  const char* debugName) noexcept = 0;
+                                                  const char* debugName, size_t specializationConstantsCount = 0,
+                                                  const SpecializationConstant* specializationConstants = nullptr) noexcept = 0;
+        // Returned PSO is compiled in background. Use ComputePSO::IsReady() and ComputePSO::Wait() to track compilation.
+        // Compilation failure is reported by ComputePSO::IsFailed() once PSO is ready.
+        // Vulkan only. D3D12 and Metal compile synchronously and return ready PSO or nullptr, same as CompileComputePSO.
+        virtual ComputePSO* CompileComputePSOAsync(const ComputePSODesc& desc) noexcept = 0;
+        virtual ComputePSO* CompileSCARComputePSOAsync(const void* scar, uint32_t sizeInBytes, RootSignature* rootSignature,
+                                                       const char* debugName, size_t specializationConstantsCount = 0,
+                                                       const SpecializationConstant* specializationConstants = nullptr) noexcept = 0;
+        // Compiles count PSOs in one batch. outPSOs must have space for count pointers. PSOs failed to compile are set to nullptr.
+        virtual void CompileComputePSOs(size_t count, const ComputePSODesc* descs, ComputePSO** outPSOs) noexcept = 0;
+        // Writes PSO cache to InitializeDesc::psoCachePath. Returns false if cache persistence is disabled or write failed.
+        // Vulkan only. D3D12 and Metal have no PSO cache persistence and always return false.
+        virtual bool SavePSOCache() noexcept = 0;
 
     public:
         // RESOURCE MANAGEMENT
@@ -41,13 +56,25 @@ namespace RHINO {
                                            ResourceUsage usage, const char* name) noexcept = 0;
         virtual Sampler* CreateSampler(const SamplerDesc& desc) noexcept = 0;
         virtual DescriptorHeap* CreateDescriptorHeap(DescriptorHeapType type, size_t descriptorsCount, const char* name) noexcept = 0;
+        virtual void CopyDescriptors(DescriptorHeap* dstHeap, size_t dstOffset, DescriptorHeap* srcHeap, size_t srcOffset,
+                                     size_t count) noexcept = 0;
         virtual Swapchain* CreateSwapchain(const SwapchainDesc& desc) noexcept = 0;
 
         //TODO: add command list target queue setting;
         virtual CommandList* AllocateCommandList(const char* name) noexcept = 0;
+        virtual FrameContext* CreateFrameContext(const FrameContextDesc& desc) noexcept = 0;
 
     public:
         virtual ASPrebuildInfo GetBLASPrebuildInfo(const BLASDesc& desc) noexcept = 0;
+        // Sizes for CommandList::BuildBLASes. Scratch size includes alignment padding between builds.
+        virtual ASPrebuildInfo GetBLASesPrebuildInfo(size_t count, const BLASDesc* descs) noexcept = 0;
+        // Non blocking. Returns false until GPU writes the size requested by CommandList::QueryBLASCompactedSizes.
+        virtual bool GetBLASCompactedSize(BLAS* blas, size_t* outSizeInBytes) noexcept = 0;
+        // Non blocking. Returns false until GPU writes the size requested by CommandList::QueryBLASSerializedSizes.
+        // Backends without acceleration structure serialization report size 0.
+        virtual bool GetBLASSerializedSize(BLAS* blas, size_t* outSizeInBytes) noexcept = 0;
+        // Reads header of blob loaded from disk and checks it against current driver and device.
+        virtual SerializedASInfo GetSerializedBLASInfo(const void* data, size_t sizeInBytes) noexcept = 0;
         virtual ASPrebuildInfo GetTLASPrebuildInfo(const TLASDesc& desc) noexcept = 0;
 
     public:
@@ -62,6 +89,11 @@ namespace RHINO {
         virtual void SignalFromQueue(Semaphore* semaphore, uint64_t value) noexcept = 0;
         virtual void SignalFromHost(Semaphore* semaphore, uint64_t value) noexcept = 0;
         virtual bool SemaphoreWaitFromHost(const Semaphore* semaphore, uint64_t value, size_t timeout) noexcept = 0;
+        // Waits until all (waitAll) or any of semaphores reach their values. Returns false on timeout.
+        virtual bool SemaphoresWaitFromHost(size_t count, const SemaphoreWaitDesc* waits, bool waitAll, size_t timeout) noexcept = 0;
+        // Calls callback once semaphore reaches value. Callbacks ready at the same time are called in registration order.
+        // Semaphore must outlive the callback. Callbacks still pending on Release are dropped.
+        virtual void OnSemaphoreValue(const Semaphore* semaphore, uint64_t value, SemaphoreCallback callback, void* userData) noexcept = 0;
         virtual void SemaphoreWaitFromQueue(const Semaphore* semaphore, uint64_t value) noexcept = 0;
         virtual uint64_t GetSemaphoreCompletedValue(const Semaphore* semaphore) noexcept = 0;
     };
@@ -67,6 +67,9 @@ namespace RHINO {
         RTV,
         DSV,
         Sampler,
+        // Typed SRV_CBV_UAV heaps. Allow tighter descriptor strides on backends with variable descriptor sizes.
+        SRV_CBV_UAV_BuffersOnly,
+        SRV_UAV_TexturesOnly,
         Count,
     };
 
@@ -177,13 +180,35 @@ namespace RHINO {
 
     class RootSignature: public Object {};
     class RTPSO : public Object {};
-    class ComputePSO : public Object {};
+    struct PSOStatistics;
+    struct Dim3D;
+
+    class ComputePSO : public Object {
+    public:
+        // PSO returned by async compilation may be still compiling. Other PSOs are always ready.
+        virtual bool IsReady() noexcept = 0;
+        virtual void Wait() noexcept = 0;
+        // Async compilation failed. Valid once ready. Failed PSO is never bound, CommandList::TrySetComputePSO returns false for it.
+        virtual bool IsFailed() noexcept = 0;
+        // Returns false if statistics are not supported. Requires InitializeDesc::capturePSOStatistics.
+        virtual bool GetStatistics(PSOStatistics* outStatistics) noexcept = 0;
+        // Thread group size declared in shader. Zero if unknown.
+        virtual Dim3D GetWorkgroupSize() noexcept = 0;
+    };
 
     class BLAS : public Resource {};
     class TLAS : public Resource {};
 
     class Semaphore : public Object {};
 
+    struct SemaphoreWaitDesc {
+        const Semaphore* semaphore = nullptr;
+        uint64_t value = 0;
+    };
+
+    // Invoked from backend waiter thread. Should not block, heavy work has to be handed off to other threads.
+    using SemaphoreCallback = void (*)(void* userData);
+
     class DescriptorHeap;
     class CommandList;
 
@@ -197,6 +222,17 @@ namespace RHINO {
         size_t depth = 0;
     };
 
+    struct InitializeDesc {
+        // File used to persist compiled PSOs between runs. PSO cache is not persisted if nullptr. Vulkan only.
+        const char* psoCachePath = nullptr;
+        // Capture driver statistics for compiled PSOs. May slow down PSO compilation.
+        bool capturePSOStatistics = false;
+        // Host semaphore waits poll semaphore value for this long before blocking the thread.
+        // Saves the thread wake up latency for short GPU jobs at the cost of burning CPU time. Zero blocks right away.
+        // Spin never exceeds wait timeout and its time is counted towards it, zero timeout wait is not spun on.
+        size_t hostWaitSpinTimeInMicroseconds = 0;
+    };
+
     struct DescriptorRangeDesc {
         DescriptorRangeType rangeType = DescriptorRangeType::CBV;
         size_t baseRegisterSlot = 0;
@@ -223,12 +259,44 @@ namespace RHINO {
         const char* entrypoint = nullptr;
     };
 
+    struct SpecializationConstant {
+        uint32_t constantID = 0;
+        // Raw 32 bit value. bool, int, uint and float constants are supported.
+        uint32_t value = 0;
+    };
+
     struct ComputePSODesc {
         RootSignature* rootSignature = nullptr;
         ShaderModule CS = {};
+        // Thread group size declared in shader. Required by CommandList::DispatchThreads. Filled from SCAR archive if reflected.
+        Dim3D workgroupSize = {};
+        // Allows CommandList::DispatchThreads to split group counts above device limits. Vulkan only, D3D12 rejects such dispatches.
+        bool splitDispatches = false;
+        // Constants not listed here keep default values declared in shader. Vulkan only, D3D12 and Metal ignore them.
+        size_t specializationConstantsCount = 0;
+        const SpecializationConstant* specializationConstants = nullptr;
         const char* debugName = "UnnamedComputePSO";
     };
 
+    struct PSOStatistic {
+        char name[64] = {};
+        double value = 0.0;
+    };
+
+    struct PSOStatistics {
+        // Values are matched by driver statistic names. Zero if not reported by driver.
+        uint32_t vectorRegistersCount = 0;
+        uint32_t scalarRegistersCount = 0;
+        uint32_t spillsCount = 0;
+        uint32_t sharedMemorySizeInBytes = 0;
+        uint32_t subgroupSize = 0;
+
+        // All statistics reported by driver.
+        static constexpr size_t MaxStatisticsCount = 64;
+        size_t statisticsCount = 0;
+        PSOStatistic statistics[MaxStatisticsCount] = {};
+    };
+
     struct RTHitGroupDesc {
         size_t closestHitShaderIndex = 0;
         bool clothestHitShaderEnabled = false;
@@ -254,6 +322,7 @@ namespace RHINO {
 
     struct RTPSODesc {
         RootSignature* rootSignature = nullptr;
+        // Modules pointing to the same bytecode are treated as entrypoints of one library and are created once.
         size_t shaderModulesCount = 0;
         const ShaderModule* shaderModules = nullptr;
         size_t recordsCount = 0;
@@ -298,9 +367,22 @@ namespace RHINO {
     struct ASPrebuildInfo {
         size_t scratchBufferSizeInBytes = 0;
         size_t MaxASSizeInBytes = 0;
+        // Scratch size for CommandList::UpdateTLAS. Zero when update is not allowed.
+        size_t updateScratchBufferSizeInBytes = 0;
     };
 
-    struct BLASDesc {
+    /**
+     * Header info of acceleration structure blob written by CommandList::SerializeBLAS.
+     */
+    struct SerializedASInfo {
+        // False when blob was written by another driver or device. Acceleration structure has to be rebuilt from its desc then.
+        bool compatible = false;
+        size_t serializedSizeInBytes = 0;
+        size_t deserializedSizeInBytes = 0;
+    };
+
+    struct BLASGeometryDesc {
+        // Optional. Vertices are read as a triangle list when not set.
         Buffer* indexBuffer = nullptr;
         size_t indexBufferStartOffset = 0;
         size_t indexCount = 0;
@@ -310,9 +392,20 @@ namespace RHINO {
         TextureFormat vertexFormat = TextureFormat::R32G32B32_FLOAT;
         size_t vertexCount = 0;
         size_t vertexStride = 0;
-        // Just one tranform value.
+        // Optional. Just one tranform value.
         Buffer* transformBuffer = nullptr;
         size_t transformBufferStartOffset = 0;
+        // Opaque geometry doesn't invoke any hit shaders.
+        bool opaque = true;
+    };
+
+    /**
+     * All geometries are built into one acceleration structure.
+     * Prefer one BLAS per mesh with many geometries over one BLAS per submesh.
+     */
+    struct BLASDesc {
+        size_t geometriesCount = 0;
+        const BLASGeometryDesc* geometries = nullptr;
     };
 
     struct BLASInstanceDesc {
@@ -327,6 +420,8 @@ namespace RHINO {
     struct TLASDesc {
         size_t blasInstancesCount = 0;
         const BLASInstanceDesc* blasInstances = nullptr;
+        // Allows CommandList::UpdateTLAS. Structure becomes slightly bigger and slower to trace.
+        bool allowUpdate = false;
     };
 
     struct ResourceTransitionBarrierDesc {
@@ -343,12 +438,20 @@ namespace RHINO {
 
     class CommandList : public Object {
     public:
+        // Discards recorded commands and starts recording anew. Previous submission of this list must be completed on GPU.
+        virtual void Reset() noexcept = 0;
         virtual void CopyBuffer(Buffer* src, Buffer* dst, size_t srcOffset, size_t dstOffset, size_t size) noexcept = 0;
         virtual void Dispatch(const DispatchDesc& desc) noexcept = 0;
+        // Dispatches enough thread groups of current compute PSO to cover threads count. Shader must bound check extra threads.
+        // Group counts above device limits require ComputePSODesc::splitDispatches, otherwise dispatch is skipped.
+        virtual void DispatchThreads(size_t threadsX, size_t threadsY, size_t threadsZ) noexcept = 0;
         virtual void DispatchRays(const DispatchRaysDesc& desc) noexcept = 0;
         virtual void Draw() noexcept = 0;
         virtual void ResourceBarrier(const ResourceBarrierDesc& desc) noexcept = 0;
+        // Waits for PSO compilation to finish. PSO failed to compile is not bound.
         virtual void SetComputePSO(ComputePSO* pso) noexcept = 0;
+        // Sets PSO only if it is ready and compiled successfully. Returns false otherwise, so the caller can skip its dispatches.
+        virtual bool TrySetComputePSO(ComputePSO* pso) noexcept = 0;
 
         virtual void SetRootSignature(RootSignature* rootSignature) noexcept = 0;
         virtual void SetHeap(DescriptorHeap* CBVSRVUAVHeap, DescriptorHeap* SamplerHeap) noexcept = 0;
@@ -357,8 +460,30 @@ namespace RHINO {
         virtual void BuildRTPSO(RTPSO* pso) noexcept = 0;
         virtual BLAS* BuildBLAS(const BLASDesc& desc, Buffer* scratchBuffer, size_t scratchBufferStartOffset,
                                 const char* name) noexcept = 0;
+        // Builds count BLASes at once, writes them to outBLASes. Scratch size is reported by RHINOInterface::GetBLASesPrebuildInfo
+        // for the same descs. Scratch start offset must be 256 bytes aligned.
+        virtual void BuildBLASes(size_t count, const BLASDesc* descs, Buffer* scratchBuffer, size_t scratchBufferStartOffset,
+                                 const char* name, BLAS** outBLASes) noexcept = 0;
+        // Writes compacted sizes of BLASes built earlier. Sizes are read back by RHINOInterface::GetBLASCompactedSize.
+        virtual void QueryBLASCompactedSizes(size_t count, BLAS* const* blases) noexcept = 0;
+        // Copies BLASes into storage of their compacted sizes, which have to be read back already.
+        // Source BLASes are retired on submission: the backend releases them once this command list finishes execution.
+        // Command list reset or released without submission leaves them owned by the caller.
+        virtual void CompactBLASes(size_t count, BLAS* const* blases, const char* name, BLAS** outCompacted) noexcept = 0;
+        // Writes serialized sizes of BLASes built earlier. Sizes are read back by RHINOInterface::GetBLASSerializedSize.
+        virtual void QueryBLASSerializedSizes(size_t count, BLAS* const* blases) noexcept = 0;
+        // Writes BLAS blob to Readback heap buffer. Serialized size has to be read back already. Offset must be 256 bytes aligned.
+        // Blob starts with driver identifier checked by RHINOInterface::GetSerializedBLASInfo on load.
+        virtual void SerializeBLAS(BLAS* blas, Buffer* dstBuffer, size_t dstBufferStartOffset) noexcept = 0;
+        // Creates BLAS from blob in Upload heap buffer. Offset must be 256 bytes aligned.
+        // Returns nullptr for incompatible blob, caller falls back to BuildBLAS with the original desc.
+        virtual BLAS* DeserializeBLAS(const SerializedASInfo& info, Buffer* srcBuffer, size_t srcBufferStartOffset,
+                                      const char* name) noexcept = 0;
         virtual TLAS* BuildTLAS(const TLASDesc& desc, Buffer* scratchBuffer, size_t scratchBufferStartOffset,
                                 const char* name) noexcept = 0;
+        // Refits TLAS built with allowUpdate to new instance data. Instances count must match the build. Instance data is written
+        // at record time to a TLAS instance buffer no recorded or executing build reads, so updates may be recorded every frame.
+        virtual void UpdateTLAS(TLAS* tlas, const TLASDesc& desc, Buffer* scratchBuffer, size_t scratchBufferStartOffset) noexcept = 0;
     };
 
     struct WriteBufferDescriptorDesc {
@@ -399,6 +524,52 @@ namespace RHINO {
         virtual void WriteSRV(const WriteTLASDescriptorDesc& desc) noexcept = 0;
 
         virtual void WriteSMP(Sampler* sampler, size_t offsetInHeap) noexcept = 0;
+
+        // Reallocates heap storage to fit newDescriptorsCount descriptors keeping already written descriptors.
+        // Previous storage is released once command lists recorded with it are executed or released.
+        // Heap must be rebound with SetHeap after the call.
+        virtual void Grow(size_t newDescriptorsCount) noexcept = 0;
+    };
+
+    struct FrameContextDesc {
+        // Frames CPU may record ahead of GPU. BeginFrame blocks only when this many frames are still executing.
+        size_t framesInFlight = 2;
+        // Per frame upload ring size. Upload ring is not created if zero.
+        size_t uploadRingSizeInBytes = 0;
+        // Per frame transient descriptor ranges. Transient heap is not created if zero.
+        size_t transientCBVSRVUAVDescriptorsCount = 0;
+        size_t transientSamplerDescriptorsCount = 0;
+        const char* debugName = "UnnamedFrameContext";
+    };
+
+    struct FrameUploadAllocation {
+        Buffer* buffer = nullptr;
+        size_t offset = 0;
+        // Persistently mapped upload ring memory at offset.
+        void* mappedData = nullptr;
+    };
+
+    /**
+     * Owns per frame command lists, upload ring and transient descriptor ranges.
+     * Frame resources are recycled once GPU completes the frame, framesInFlight frames later.
+     */
+    class FrameContext : public Object {
+    public:
+        // Waits until GPU completes the frame previously recorded in the same slot and recycles its resources.
+        virtual void BeginFrame() noexcept = 0;
+        // Submits command lists allocated during frame in allocation order and signals frame completion.
+        virtual void EndFrame() noexcept = 0;
+        // Slot of current frame in [0, framesInFlight).
+        virtual size_t GetFrameSlot() noexcept = 0;
+
+        // Submitted by EndFrame and reset for reuse by later frames of the same slot once frame completes.
+        // Keeps name of its first allocation. Must not be submitted, reset or released manually.
+        virtual CommandList* AllocateCommandList(const char* name) noexcept = 0;
+        // Returns false if upload ring of current frame is exhausted.
+        virtual bool AllocateUpload(size_t sizeInBytes, size_t alignment, FrameUploadAllocation* outAllocation) noexcept = 0;
+        // Returns offset of count descriptors in transient heap or ~0 if exhausted. SRV_CBV_UAV and Sampler heaps only.
+        virtual size_t AllocateTransientDescriptors(DescriptorHeapType heapType, size_t count) noexcept = 0;
+        virtual DescriptorHeap* GetTransientHeap(DescriptorHeapType heapType) noexcept = 0;
     };
 
     struct SwapchainDesc {
@@ -16,7 +16,7 @@ namespace RHINO::APID3D12 {
 
     D3D12Backend::D3D12Backend() noexcept : m_Device(nullptr) {}
 
-    void D3D12Backend::Initialize() noexcept {
+    void D3D12Backend::Initialize(const InitializeDesc& desc) noexcept {
         CreateDXGIFactory(IID_PPV_ARGS(&m_DXGIFactory));
 
         IDXGIAdapter* adapter;
@@ -36,10 +36,14 @@ namespace RHINO::APID3D12 {
         m_Device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&m_ComputeQueue));
         queueDesc.Type = D3D12_COMMAND_LIST_TYPE_COPY;
         m_Device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&m_CopyQueue));
+
+        m_HostWaitSpinTimeInMicroseconds = desc.hostWaitSpinTimeInMicroseconds;
+        m_SemaphoreWaiter.Initialize(m_Device);
     }
 
     void D3D12Backend::Release() noexcept {
         // TODO: finish garbage collector thread and wait for it.
+        m_SemaphoreWaiter.Release();
         m_GarbageCollector.Release();
         m_DXGIFactory->Release();
     }
@@ -140,11 +144,17 @@ namespace RHINO::APID3D12 {
         std::vector<D3D12_SHADER_BYTECODE> bytecodeRefs{};
 
         CD3DX12_STATE_OBJECT_DESC raytracingPipeline{D3D12_STATE_OBJECT_TYPE_RAYTRACING_PIPELINE};
+        // Library entrypoints share bytecode, so one library subobject exports all of them.
+        std::unordered_map<const uint8_t*, CD3DX12_DXIL_LIBRARY_SUBOBJECT*> libraries{};
+        bytecodeRefs.reserve(desc.shaderModulesCount);
         for (size_t i = 0; i < desc.shaderModulesCount; ++i) {
             const ShaderModule& shaderModule = desc.shaderModules[i];
-            auto lib = raytracingPipeline.CreateSubobject<CD3DX12_DXIL_LIBRARY_SUBOBJECT>();
-            D3D12_SHADER_BYTECODE& libdxil = bytecodeRefs.emplace_back(shaderModule.bytecode, shaderModule.bytecodeSize);
-            lib->SetDXILLibrary(&libdxil);
+            CD3DX12_DXIL_LIBRARY_SUBOBJECT*& lib = libraries[shaderModule.bytecode];
+            if (!lib) {
+                lib = raytracingPipeline.CreateSubobject<CD3DX12_DXIL_LIBRARY_SUBOBJECT>();
+                D3D12_SHADER_BYTECODE& libdxil = bytecodeRefs.emplace_back(shaderModule.bytecode, shaderModule.bytecodeSize);
+                lib->SetDXILLibrary(&libdxil);
+            }
             const std::string entrypoint = shaderModule.entrypoint;
             const auto wEntrypoint = wStrg.emplace_back(entrypoint.cbegin(), entrypoint.cend()).c_str();
             const auto exportName = wStrg.emplace_back(SHADER_ID_PREFIX + std::to_wstring(i)).c_str();
@@ -233,6 +243,7 @@ namespace RHINO::APID3D12 {
     }
 
     ComputePSO* D3D12Backend::CompileComputePSO(const ComputePSODesc& desc) noexcept {
+        // DXIL has no specialization constants, desc.specializationConstants are ignored.
         auto* d3d12RootSignature = INTERPRET_AS<D3D12RootSignature*>(desc.rootSignature);
 
         auto* result = new D3D12ComputePSO{};
@@ -242,12 +253,26 @@ namespace RHINO::APID3D12 {
         psoDesc.CS.pShaderBytecode = desc.CS.bytecode;
         psoDesc.CS.BytecodeLength = desc.CS.bytecodeSize;
 
-        m_Device->CreateComputePipelineState(&psoDesc, IID_PPV_ARGS(&result->PSO));
+        if (FAILED(m_Device->CreateComputePipelineState(&psoDesc, IID_PPV_ARGS(&result->PSO)))) {
+            delete result;
+            return nullptr;
+        }
+        result->SetWorkgroupSize(desc.workgroupSize);
 
         SetDebugName(result->PSO, desc.debugName);
         return result;
     }
 
+    ComputePSO* D3D12Backend::CompileComputePSOAsync(const ComputePSODesc& desc) noexcept {
+        // Compiled synchronously, returned PSO is ready right away.
+        return CompileComputePSO(desc);
+    }
+
+    bool D3D12Backend::SavePSOCache() noexcept {
+        // PSO cache persistence is Vulkan only.
+        return false;
+    }
+
     Buffer* D3D12Backend::CreateBuffer(size_t size, ResourceHeapType heapType, ResourceUsage usage,
                                        size_t structuredStride, const char* name) noexcept {
         RHINO_UNUSED_VAR(structuredStride);
@@ -348,6 +373,7 @@ namespace RHINO::APID3D12 {
     DescriptorHeap* D3D12Backend::CreateDescriptorHeap(DescriptorHeapType heapType, size_t descriptorsCount, const char* name) noexcept {
         auto* result = new D3D12DescriptorHeap{};
         result->device = m_Device;
+        result->descriptorsCount = descriptorsCount;
 
         D3D12_DESCRIPTOR_HEAP_TYPE nativeHeapType = Convert::ToD3D12DescriptorHeapType(heapType);
         D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
@@ -359,6 +385,7 @@ namespace RHINO::APID3D12 {
         heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
         RHINO_D3DS(m_Device->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&result->GPUDescriptorHeap)));
 
+        result->heapType = nativeHeapType;
         result->descriptorHandleIncrementSize = m_Device->GetDescriptorHandleIncrementSize(nativeHeapType);
 
         result->CPUHeapCPUStartHandle = result->CPUDescriptorHeap->GetCPUDescriptorHandleForHeapStart();
@@ -371,6 +398,18 @@ namespace RHINO::APID3D12 {
         return result;
     }
 
+    void D3D12Backend::CopyDescriptors(DescriptorHeap* dstHeap, size_t dstOffset, DescriptorHeap* srcHeap, size_t srcOffset,
+                                       size_t count) noexcept {
+        auto* d3d12DstHeap = static_cast<D3D12DescriptorHeap*>(dstHeap);
+        auto* d3d12SrcHeap = static_cast<D3D12DescriptorHeap*>(srcHeap);
+        assert(d3d12DstHeap->heapType == d3d12SrcHeap->heapType);
+
+        // Shader visible heaps are write-combined, so the non shader visible copy is always used as a source.
+        D3D12_CPU_DESCRIPTOR_HANDLE srcHandle = d3d12SrcHeap->GetCPUHeapCPUHandle(srcOffset);
+        m_Device->CopyDescriptorsSimple(count, d3d12DstHeap->GetCPUHeapCPUHandle(dstOffset), srcHandle, d3d12DstHeap->heapType);
+        m_Device->CopyDescriptorsSimple(count, d3d12DstHeap->GetGPUHeapCPUHandle(dstOffset), srcHandle, d3d12DstHeap->heapType);
+    }
+
     Swapchain* D3D12Backend::CreateSwapchain(const SwapchainDesc& desc) noexcept {
         auto* result = new D3D12Swapchain{};
         result->Initialize(m_DXGIFactory, m_Device, m_DefaultQueue, desc);
@@ -389,24 +428,31 @@ namespace RHINO::APID3D12 {
         // https://docs.microsoft.com/en-us/windows/win32/api/d3d12/nf-d3d12-id3d12device5-getraytracingaccelerationstructureprebuildinfo
         constexpr D3D12_GPU_VIRTUAL_ADDRESS dummyNotNullPointer = 0x1;
 
-        D3D12_RAYTRACING_GEOMETRY_DESC geometryDesc = {};
-        geometryDesc.Type = D3D12_RAYTRACING_GEOMETRY_TYPE_TRIANGLES;
-        geometryDesc.Triangles.IndexBuffer = dummyNotNullPointer;
-        geometryDesc.Triangles.IndexCount = desc.indexCount;
-        geometryDesc.Triangles.IndexFormat = Convert::ToDXGIFormat(desc.indexFormat);
-        geometryDesc.Triangles.Transform3x4 = 0;
-        geometryDesc.Triangles.VertexFormat = Convert::ToDXGIFormat(desc.vertexFormat);
-        geometryDesc.Triangles.VertexCount = desc.vertexCount;
-        geometryDesc.Triangles.VertexBuffer.StartAddress = dummyNotNullPointer;
-        geometryDesc.Triangles.VertexBuffer.StrideInBytes = desc.vertexStride;
+        std::vector<D3D12_RAYTRACING_GEOMETRY_DESC> geometryDescs(desc.geometriesCount);
+        for (size_t i = 0; i < desc.geometriesCount; ++i) {
+            const BLASGeometryDesc& geometry = desc.geometries[i];
+            const bool indexed = geometry.indexBuffer;
+
+            D3D12_RAYTRACING_GEOMETRY_DESC& geometryDesc = geometryDescs[i];
+            geometryDesc.Type = D3D12_RAYTRACING_GEOMETRY_TYPE_TRIANGLES;
+            geometryDesc.Flags = geometry.opaque ? D3D12_RAYTRACING_GEOMETRY_FLAG_OPAQUE : D3D12_RAYTRACING_GEOMETRY_FLAG_NONE;
+            geometryDesc.Triangles.IndexBuffer = indexed ? dummyNotNullPointer : 0;
+            geometryDesc.Triangles.IndexCount = indexed ? geometry.indexCount : 0;
+            geometryDesc.Triangles.IndexFormat = indexed ? Convert::ToDXGIFormat(geometry.indexFormat) : DXGI_FORMAT_UNKNOWN;
+            geometryDesc.Triangles.Transform3x4 = geometry.transformBuffer ? dummyNotNullPointer : 0;
+            geometryDesc.Triangles.VertexFormat = Convert::ToDXGIFormat(geometry.vertexFormat);
+            geometryDesc.Triangles.VertexCount = geometry.vertexCount;
+            geometryDesc.Triangles.VertexBuffer.StartAddress = dummyNotNullPointer;
+            geometryDesc.Triangles.VertexBuffer.StrideInBytes = geometry.vertexStride;
+        }
 
         D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS inputsDesc = {};
         inputsDesc.DescsLayout = D3D12_ELEMENTS_LAYOUT_ARRAY;
         inputsDesc.Flags = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_PREFER_FAST_TRACE |
                            D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_ALLOW_COMPACTION;
-        inputsDesc.NumDescs = 1;
+        inputsDesc.NumDescs = static_cast<UINT>(geometryDescs.size());
         inputsDesc.Type = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL;
-        inputsDesc.pGeometryDescs = &geometryDesc;
+        inputsDesc.pGeometryDescs = geometryDescs.data();
 
         D3D12_RAYTRACING_ACCELERATION_STRUCTURE_PREBUILD_INFO info = {};
         m_Device->GetRaytracingAccelerationStructurePrebuildInfo(&inputsDesc, &info);
@@ -416,11 +462,53 @@ namespace RHINO::APID3D12 {
         return {scratchSize, BLASSize};
     }
 
+    ASPrebuildInfo D3D12Backend::GetBLASesPrebuildInfo(size_t count, const BLASDesc* descs) noexcept {
+        // Per BLAS sizes are already aligned, so regions are laid out back to back.
+        ASPrebuildInfo result{};
+        for (size_t i = 0; i < count; ++i) {
+            const ASPrebuildInfo info = GetBLASPrebuildInfo(descs[i]);
+            result.scratchBufferSizeInBytes += info.scratchBufferSizeInBytes;
+            result.MaxASSizeInBytes += info.MaxASSizeInBytes;
+        }
+        return result;
+    }
+
+    bool D3D12Backend::GetBLASCompactedSize(BLAS* blas, size_t* outSizeInBytes) noexcept {
+        auto* d3d12BLAS = INTERPRET_AS<D3D12BLAS*>(blas);
+        return d3d12BLAS->compactedSizeQuery.GetSize(outSizeInBytes);
+    }
+
+    bool D3D12Backend::GetBLASSerializedSize(BLAS* blas, size_t* outSizeInBytes) noexcept {
+        auto* d3d12BLAS = INTERPRET_AS<D3D12BLAS*>(blas);
+        return d3d12BLAS->serializedSizeQuery.GetSize(outSizeInBytes);
+    }
+
+    SerializedASInfo D3D12Backend::GetSerializedBLASInfo(const void* data, size_t sizeInBytes) noexcept {
+        SerializedASInfo result{};
+        if (sizeInBytes < sizeof(D3D12_SERIALIZED_RAYTRACING_ACCELERATION_STRUCTURE_HEADER)) {
+            return result;
+        }
+
+        D3D12_SERIALIZED_RAYTRACING_ACCELERATION_STRUCTURE_HEADER header{};
+        memcpy(&header, data, sizeof(header));
+        const D3D12_DRIVER_MATCHING_IDENTIFIER_STATUS status = m_Device->CheckDriverMatchingIdentifier(
+                D3D12_SERIALIZED_DATA_RAYTRACING_ACCELERATION_STRUCTURE, &header.DriverMatchingIdentifier);
+
+        result.serializedSizeInBytes = header.SerializedSizeInBytesIncludingHeader;
+        result.deserializedSizeInBytes = header.DeserializedSizeInBytes;
+        result.compatible = status == D3D12_DRIVER_MATCHING_IDENTIFIER_COMPATIBLE_WITH_DEVICE &&
+                            header.SerializedSizeInBytesIncludingHeader <= sizeInBytes;
+        return result;
+    }
+
     ASPrebuildInfo D3D12Backend::GetTLASPrebuildInfo(const TLASDesc& desc) noexcept {
         D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS inputsDesc = {};
         inputsDesc.Type = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL;
         inputsDesc.DescsLayout = D3D12_ELEMENTS_LAYOUT_ARRAY;
         inputsDesc.Flags = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_PREFER_FAST_TRACE;
+        if (desc.allowUpdate) {
+            inputsDesc.Flags |= D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_ALLOW_UPDATE;
+        }
         inputsDesc.NumDescs = desc.blasInstancesCount;
 
         D3D12_RAYTRACING_ACCELERATION_STRUCTURE_PREBUILD_INFO info = {};
@@ -428,12 +516,15 @@ namespace RHINO::APID3D12 {
 
         auto scratchSize = RHINO_CEIL_TO_POWER_OF_TWO(info.ScratchDataSizeInBytes, D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BYTE_ALIGNMENT);
         auto BLASSize = RHINO_CEIL_TO_POWER_OF_TWO(info.ResultDataMaxSizeInBytes, D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BYTE_ALIGNMENT);
-        return {scratchSize, BLASSize};
+        auto updateScratchSize = RHINO_CEIL_TO_POWER_OF_TWO(info.UpdateScratchDataSizeInBytes,
+                                                            D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BYTE_ALIGNMENT);
+        return {scratchSize, BLASSize, desc.allowUpdate ? updateScratchSize : 0};
     }
 
     void D3D12Backend::SubmitCommandList(CommandList* cmd) noexcept {
         auto d3d12CMD = INTERPRET_AS<D3D12CommandList*>(cmd);
         d3d12CMD->SumbitToQueue(m_DefaultQueue);
+        m_GarbageCollector.CollectGarbage();
     }
 
     void D3D12Backend::SwapchainPresent(Swapchain* swapchain, Texture2D* toPresent, size_t width, size_t height) noexcept {
@@ -461,13 +552,53 @@ namespace RHINO::APID3D12 {
     bool D3D12Backend::SemaphoreWaitFromHost(const Semaphore* semaphore, uint64_t value, size_t timeout) noexcept {
         const auto* d3d12Semaphore = INTERPRET_AS<const D3D12Semaphore*>(semaphore);
 
-        HANDLE event = CreateEventA(nullptr, true, false, "RHINO.WaitForSemaphore");
+        const bool reached = SpinWait<std::milli>(m_HostWaitSpinTimeInMicroseconds, timeout, INFINITE, [&]() {
+            return d3d12Semaphore->fence->GetCompletedValue() >= value;
+        });
+        if (reached) {
+            return true;
+        }
+
+        // Unnamed event, named one would be shared between concurrent waits.
+        HANDLE event = CreateEventA(nullptr, true, false, nullptr);
         d3d12Semaphore->fence->SetEventOnCompletion(value, event);
-        const DWORD res = WaitForSingleObject(event, timeout);
+        const DWORD res = WaitForSingleObject(event, static_cast<DWORD>(std::min<size_t>(timeout, INFINITE)));
+        CloseHandle(event);
+        return res == WAIT_OBJECT_0;
+    }
+
+    bool D3D12Backend::SemaphoresWaitFromHost(size_t count, const SemaphoreWaitDesc* waits, bool waitAll, size_t timeout) noexcept {
+        std::vector<ID3D12Fence*> fences(count);
+        std::vector<UINT64> values(count);
+        for (size_t i = 0; i < count; ++i) {
+            fences[i] = INTERPRET_AS<const D3D12Semaphore*>(waits[i].semaphore)->fence;
+            values[i] = waits[i].value;
+        }
+
+        const bool reached = SpinWait<std::milli>(m_HostWaitSpinTimeInMicroseconds, timeout, INFINITE, [&]() {
+            size_t reachedCount = 0;
+            for (size_t i = 0; i < count; ++i) {
+                reachedCount += fences[i]->GetCompletedValue() >= values[i] ? 1 : 0;
+            }
+            return waitAll ? reachedCount == count : reachedCount > 0;
+        });
+        if (reached) {
+            return true;
+        }
+
+        const D3D12_MULTIPLE_FENCE_WAIT_FLAGS flags = waitAll ? D3D12_MULTIPLE_FENCE_WAIT_FLAG_ALL : D3D12_MULTIPLE_FENCE_WAIT_FLAG_ANY;
+        HANDLE event = CreateEventA(nullptr, true, false, nullptr);
+        m_Device->SetEventOnMultipleFenceCompletion(fences.data(), values.data(), static_cast<UINT>(count), flags, event);
+        const DWORD res = WaitForSingleObject(event, static_cast<DWORD>(std::min<size_t>(timeout, INFINITE)));
         CloseHandle(event);
         return res == WAIT_OBJECT_0;
     }
 
+    void D3D12Backend::OnSemaphoreValue(const Semaphore* semaphore, uint64_t value, SemaphoreCallback callback, void* userData) noexcept {
+        const auto* d3d12Semaphore = INTERPRET_AS<const D3D12Semaphore*>(semaphore);
+        m_SemaphoreWaiter.AddCallback(d3d12Semaphore->fence, value, callback, userData);
+    }
+
     void D3D12Backend::SemaphoreWaitFromQueue(const Semaphore* semaphore, uint64_t value) noexcept {
         const auto* d3d12Semaphore = INTERPRET_AS<const D3D12Semaphore*>(semaphore);
         m_DefaultQueue->Wait(d3d12Semaphore->fence, value);
@@ -7,6 +7,7 @@
 #include "RHINOInterfaceImplBase.h"
 #include "D3D12BackendTypes.h"
 #include "D3D12GarbageCollector.h"
+#include "D3D12SemaphoreWaiter.h"
 
 namespace RHINO::APID3D12 {
     class D3D12Backend : public RHINOInterfaceImplBase {
@@ -14,13 +15,15 @@ namespace RHINO::APID3D12 {
         explicit D3D12Backend() noexcept;
 
     public:
-        void Initialize() noexcept final;
+        void Initialize(const InitializeDesc& desc) noexcept final;
         void Release() noexcept final;
 
     public:
         RootSignature* SerializeRootSignature(const RootSignatureDesc& desc) noexcept final;
         RTPSO* CreateRTPSO(const RTPSODesc& desc) noexcept final;
         ComputePSO* CompileComputePSO(const ComputePSODesc& desc) noexcept final;
+        ComputePSO* CompileComputePSOAsync(const ComputePSODesc& desc) noexcept final;
+        bool SavePSOCache() noexcept final;
 
     public:
         Buffer* CreateBuffer(size_t size, ResourceHeapType heapType, ResourceUsage usage, size_t structuredStride, const char* name) noexcept final;
@@ -31,11 +34,17 @@ namespace RHINO::APID3D12 {
                                    ResourceUsage usage, const char* name) noexcept final;
         Sampler* CreateSampler(const SamplerDesc& desc) noexcept final;
         DescriptorHeap* CreateDescriptorHeap(DescriptorHeapType heapType, size_t descriptorsCount, const char* name) noexcept final;
+        void CopyDescriptors(DescriptorHeap* dstHeap, size_t dstOffset, DescriptorHeap* srcHeap, size_t srcOffset,
+                             size_t count) noexcept final;
         Swapchain* CreateSwapchain(const SwapchainDesc& desc) noexcept final;
 
         CommandList* AllocateCommandList(const char* name) noexcept final;
     public:
         ASPrebuildInfo GetBLASPrebuildInfo(const BLASDesc& desc) noexcept final;
+        ASPrebuildInfo GetBLASesPrebuildInfo(size_t count, const BLASDesc* descs) noexcept final;
+        bool GetBLASCompactedSize(BLAS* blas, size_t* outSizeInBytes) noexcept final;
+        bool GetBLASSerializedSize(BLAS* blas, size_t* outSizeInBytes) noexcept final;
+        SerializedASInfo GetSerializedBLASInfo(const void* data, size_t sizeInBytes) noexcept final;
         ASPrebuildInfo GetTLASPrebuildInfo(const TLASDesc& desc) noexcept final;
 
     public:
@@ -48,6 +57,8 @@ namespace RHINO::APID3D12 {
         void SignalFromQueue(Semaphore* semaphore, uint64_t value) noexcept final;
         void SignalFromHost(Semaphore* semaphore, uint64_t value) noexcept final;
         bool SemaphoreWaitFromHost(const Semaphore* semaphore, uint64_t value, size_t timeout) noexcept final;
+        bool SemaphoresWaitFromHost(size_t count, const SemaphoreWaitDesc* waits, bool waitAll, size_t timeout) noexcept final;
+        void OnSemaphoreValue(const Semaphore* semaphore, uint64_t value, SemaphoreCallback callback, void* userData) noexcept final;
         void SemaphoreWaitFromQueue(const Semaphore* semaphore, uint64_t value) noexcept final;
         uint64_t GetSemaphoreCompletedValue(const Semaphore* semaphore) noexcept final;
 
@@ -61,7 +72,10 @@ namespace RHINO::APID3D12 {
         ID3D12CommandQueue* m_ComputeQueue = nullptr;
         ID3D12CommandQueue* m_CopyQueue = nullptr;
 
+        size_t m_HostWaitSpinTimeInMicroseconds = 0;
+
         D3D12GarbageCollector m_GarbageCollector = {};
+        D3D12SemaphoreWaiter m_SemaphoreWaiter = {};
     };
 }// namespace RHINO::APID3D12
 
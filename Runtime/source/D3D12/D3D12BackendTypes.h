@@ -51,12 +51,89 @@ namespace RHINO::APID3D12 {
         }
     };
 
+    /**
+     * Postbuild info of one BLAS in readback buffer shared by BLASes queried together.
+     * Fence value marks when the buffer is written.
+     */
+    struct D3D12ASPostbuildInfoQuery {
+        ID3D12Resource* readback = nullptr;
+        size_t offset = 0;
+        ID3D12Fence* fence = nullptr;
+        uint64_t fenceValue = 0;
+
+        // Returns false while info is not requested or not yet written by GPU.
+        // Compacted size and serialization info descs both start with the size.
+        bool GetSize(size_t* outSize) const noexcept {
+            if (!this->readback || this->fence->GetCompletedValue() < this->fenceValue) {
+                return false;
+            }
+            const D3D12_RANGE readRange{this->offset, this->offset + sizeof(UINT64)};
+            const D3D12_RANGE writtenRange{0, 0};
+            uint8_t* mapped = nullptr;
+            this->readback->Map(0, &readRange, reinterpret_cast<void**>(&mapped));
+            UINT64 size = 0;
+            memcpy(&size, mapped + this->offset, sizeof(size));
+            this->readback->Unmap(0, &writtenRange);
+            *outSize = size;
+            return true;
+        }
+
+        void Reset(ID3D12Resource* newReadback, size_t newOffset, ID3D12Fence* newFence, uint64_t newFenceValue) noexcept {
+            newReadback->AddRef();
+            newFence->AddRef();
+            Release();
+            this->readback = newReadback;
+            this->offset = newOffset;
+            this->fence = newFence;
+            this->fenceValue = newFenceValue;
+        }
+
+        void Release() noexcept {
+            if (this->readback) {
+                this->readback->Release();
+                this->fence->Release();
+                this->readback = nullptr;
+                this->fence = nullptr;
+            }
+        }
+    };
+
     class D3D12BLAS : public BLASBase {
     public:
         ID3D12Resource* buffer = nullptr;
+        D3D12ASPostbuildInfoQuery compactedSizeQuery{};
+        D3D12ASPostbuildInfoQuery serializedSizeQuery{};
 
     public:
         void Release() noexcept final {
+            this->buffer->Release();
+            this->compactedSizeQuery.Release();
+            this->serializedSizeQuery.Release();
+            delete this;
+        }
+    };
+
+    /**
+     * Upload heap TLAS instance buffer read by builds directly. Mapped for its whole lifetime.
+     */
+    struct D3D12TLASInstanceBuffer {
+        ID3D12Resource* buffer = nullptr;
+        D3D12_RAYTRACING_INSTANCE_DESC* mapped = nullptr;
+        // Host copy of written instances, so writes skip unchanged ones.
+        std::vector<D3D12_RAYTRACING_INSTANCE_DESC> instances{};
+        // Fence of command list that recorded the last build reading the buffer and the value its submission signals.
+        ID3D12Fence* lastUseFence = nullptr;
+        uint64_t lastUseFenceValue = 0;
+
+        bool IsIdle() const noexcept {
+            return !this->lastUseFence || this->lastUseFence->GetCompletedValue() >= this->lastUseFenceValue;
+        }
+
+        void Release() noexcept {
+            if (this->lastUseFence) {
+                this->lastUseFence->Release();
+            }
+            this->buffer->Unmap(0, nullptr);
             this->buffer->Release();
             delete this;
         }
@@ -65,10 +142,18 @@ namespace RHINO::APID3D12 {
     class D3D12TLAS : public TLASBase {
     public:
         ID3D12Resource* buffer = nullptr;
+        bool allowUpdate = false;
+        size_t instancesCount = 0;
+
+        // Builds and updates write instances to an idle buffer of the ring, ring grows while all of them are in use.
+        std::vector<D3D12TLASInstanceBuffer*> instanceBuffers{};
 
     public:
         void Release() noexcept final {
             this->buffer->Release();
+            for (D3D12TLASInstanceBuffer* instanceBuffer : this->instanceBuffers) {
+                instanceBuffer->Release();
+            }
             delete this;
         }
     };
@@ -104,7 +189,7 @@ namespace RHINO::APID3D12 {
         }
     };
 
-    class D3D12ComputePSO : public ComputePSO {
+    class D3D12ComputePSO : public ComputePSOBase {
     public:
         ID3D12PipelineState* PSO = nullptr;
 
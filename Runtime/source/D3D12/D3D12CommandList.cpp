@@ -5,6 +5,7 @@
 #include "D3D12DescriptorHeap.h"
 #include "D3D12Converters.h"
 #include "D3D12Utils.h"
+#include "Utils/ASInstancePacking.h"
 
 namespace RHINO::APID3D12 {
     using namespace std::string_literals;
@@ -20,6 +21,18 @@ namespace RHINO::APID3D12 {
         RHINO_D3DS(m_Device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_Fence)));
     }
 
+    void D3D12CommandList::Reset() noexcept {
+        // Heaps referenced since last submission stay tracked by garbage collector until the next one completes.
+        m_ReferencedHeaps.clear();
+        // Ownership of compaction sources is passed on submission only.
+        m_CompactedSources.clear();
+        m_CurRootSignature = nullptr;
+        m_CurComputePSO = nullptr;
+
+        RHINO_D3DS(m_Allocator->Reset());
+        RHINO_D3DS(m_Cmd->Reset(m_Allocator, nullptr));
+    }
+
     void D3D12CommandList::Release() noexcept {
         m_Allocator->Release();
         m_Cmd->Release();
@@ -31,12 +44,38 @@ namespace RHINO::APID3D12 {
         m_Cmd->Close();
         ID3D12CommandList* list = m_Cmd;
         queue->ExecuteCommandLists(1, &list);
+        // Source storage lives until this submission is executed, the BLAS object itself is released right away.
+        for (D3D12BLAS* source : m_CompactedSources) {
+            source->buffer->AddRef();
+            m_GarbageCollector->AddGarbage(source->buffer, m_Fence, m_FenceNextVal);
+            source->Release();
+        }
+        m_CompactedSources.clear();
         queue->Signal(m_Fence, m_FenceNextVal++);
+        m_ReferencedHeaps.clear();
     }
 
     void D3D12CommandList::Dispatch(const DispatchDesc& desc) noexcept {
         m_Cmd->Dispatch(desc.dimensionsX, desc.dimensionsY, desc.dimensionsZ);
     }
+    void D3D12CommandList::DispatchThreads(size_t threadsX, size_t threadsY, size_t threadsZ) noexcept {
+        assert(m_CurComputePSO);
+        const Dim3D workgroupSize = m_CurComputePSO->GetWorkgroupSize();
+        assert(workgroupSize.width && workgroupSize.height && workgroupSize.depth && "Workgroup size of compute PSO is unknown.");
+
+        DispatchDesc desc{};
+        desc.dimensionsX = (threadsX + workgroupSize.width - 1) / workgroupSize.width;
+        desc.dimensionsY = (threadsY + workgroupSize.height - 1) / workgroupSize.height;
+        desc.dimensionsZ = (threadsZ + workgroupSize.depth - 1) / workgroupSize.depth;
+        // D3D12 has no dispatch base, SV_GroupID of split dispatches would restart from zero. Such dispatches are rejected.
+        if (desc.dimensionsX > D3D12_CS_DISPATCH_MAX_THREAD_GROUPS_PER_DIMENSION ||
+            desc.dimensionsY > D3D12_CS_DISPATCH_MAX_THREAD_GROUPS_PER_DIMENSION ||
+            desc.dimensionsZ > D3D12_CS_DISPATCH_MAX_THREAD_GROUPS_PER_DIMENSION) {
+            assert(false && "Thread groups count exceeds D3D12_CS_DISPATCH_MAX_THREAD_GROUPS_PER_DIMENSION.");
+            return;
+        }
+        Dispatch(desc);
+    }
     void D3D12CommandList::DispatchRays(const DispatchRaysDesc& desc) noexcept {
         auto* d3d12PSO = static_cast<D3D12RTPSO*>(desc.pso);
 
@@ -111,9 +150,22 @@ namespace RHINO::APID3D12 {
 
     void D3D12CommandList::SetComputePSO(ComputePSO* pso) noexcept {
         auto* d3d12ComputePSO = static_cast<D3D12ComputePSO*>(pso);
+        d3d12ComputePSO->Wait();
+        if (d3d12ComputePSO->IsFailed()) {
+            return;
+        }
+        m_CurComputePSO = d3d12ComputePSO;
         m_Cmd->SetPipelineState(d3d12ComputePSO->PSO);
     }
 
+    bool D3D12CommandList::TrySetComputePSO(ComputePSO* pso) noexcept {
+        if (!pso->IsReady() || pso->IsFailed()) {
+            return false;
+        }
+        SetComputePSO(pso);
+        return true;
+    }
+
     void D3D12CommandList::SetRootSignature(RootSignature* rootSignature) noexcept {
         m_CurRootSignature = INTERPRET_AS<D3D12RootSignature*>(rootSignature);
         m_Cmd->SetComputeRootSignature(m_CurRootSignature->rootSignature);
@@ -123,9 +175,11 @@ namespace RHINO::APID3D12 {
         auto* d3d12CBVSRVUAVHeap = static_cast<D3D12DescriptorHeap*>(CBVSRVUAVHeap);
         auto* d3d12SamplerHeap = static_cast<D3D12DescriptorHeap*>(samplerHeap);
 
+        ReferenceHeap(d3d12CBVSRVUAVHeap->GPUDescriptorHeap);
         if (!samplerHeap) {
             m_Cmd->SetDescriptorHeaps(1, &d3d12CBVSRVUAVHeap->GPUDescriptorHeap);
         } else {
+            ReferenceHeap(d3d12SamplerHeap->GPUDescriptorHeap);
             ID3D12DescriptorHeap* heaps[] = {d3d12CBVSRVUAVHeap->GPUDescriptorHeap, d3d12SamplerHeap->GPUDescriptorHeap};
             m_Cmd->SetDescriptorHeaps(2, heaps);
         }
@@ -139,6 +193,15 @@ namespace RHINO::APID3D12 {
         }
     }
 
+    void D3D12CommandList::ReferenceHeap(ID3D12DescriptorHeap* heap) noexcept {
+        if (std::find(m_ReferencedHeaps.begin(), m_ReferencedHeaps.end(), heap) != m_ReferencedHeaps.end()) {
+            return;
+        }
+        heap->AddRef();
+        m_GarbageCollector->AddGarbage(heap, m_Fence, m_FenceNextVal);
+        m_ReferencedHeaps.push_back(heap);
+    }
+
     void D3D12CommandList::BuildRTPSO(RTPSO* pso) noexcept {
         auto* d3d12PSO = static_cast<D3D12RTPSO*>(pso);
         assert(d3d12PSO->tableRecordStride >= D3D12_SHADER_IDENTIFIER_SIZE_IN_BYTES);
@@ -164,146 +227,220 @@ namespace RHINO::APID3D12 {
 
     BLAS* D3D12CommandList::BuildBLAS(const BLASDesc& desc, Buffer* scratchBuffer, size_t scratchBufferStartOffset,
                                       const char* name) noexcept {
-        auto* indexBuffer = static_cast<D3D12Buffer*>(desc.indexBuffer);
-        auto* vertexBuffer = static_cast<D3D12Buffer*>(desc.vertexBuffer);
-        auto* transform = static_cast<D3D12Buffer*>(desc.transformBuffer);
         auto* scratch = static_cast<D3D12Buffer*>(scratchBuffer);
+        size_t scratchSize = 0;
+        return RecordBLASBuild(desc, scratch->buffer->GetGPUVirtualAddress() + scratchBufferStartOffset, name, &scratchSize);
+    }
+
+    void D3D12CommandList::BuildBLASes(size_t count, const BLASDesc* descs, Buffer* scratchBuffer, size_t scratchBufferStartOffset,
+                                       const char* name, BLAS** outBLASes) noexcept {
+        // D3D12 has no multi build call. Builds are recorded back to back without barriers between them, as scratch regions don't overlap.
+        auto* scratch = static_cast<D3D12Buffer*>(scratchBuffer);
+        D3D12_GPU_VIRTUAL_ADDRESS scratchAddress = scratch->buffer->GetGPUVirtualAddress() + scratchBufferStartOffset;
+        for (size_t i = 0; i < count; ++i) {
+            size_t scratchSize = 0;
+            outBLASes[i] = RecordBLASBuild(descs[i], scratchAddress, name, &scratchSize);
+            scratchAddress += scratchSize;
+        }
+    }
 
+    D3D12BLAS* D3D12CommandList::RecordBLASBuild(const BLASDesc& desc, D3D12_GPU_VIRTUAL_ADDRESS scratchAddress, const char* name,
+                                                 size_t* outScratchSizeInBytes) noexcept {
         auto result = new D3D12BLAS{};
 
-        D3D12_GPU_VIRTUAL_ADDRESS trnsfrmAddr = transform ? transform->buffer->GetGPUVirtualAddress() + desc.transformBufferStartOffset : 0;
-        D3D12_RAYTRACING_GEOMETRY_DESC geometryDesc{D3D12_RAYTRACING_GEOMETRY_TYPE_TRIANGLES};
-        geometryDesc.Triangles.IndexBuffer = indexBuffer->buffer->GetGPUVirtualAddress() + desc.indexBufferStartOffset;
-        geometryDesc.Triangles.IndexCount = desc.indexCount;
-        geometryDesc.Triangles.IndexFormat = Convert::ToDXGIFormat(desc.indexFormat);
-        geometryDesc.Triangles.Transform3x4 = trnsfrmAddr;
-        geometryDesc.Triangles.VertexFormat = Convert::ToDXGIFormat(desc.vertexFormat);
-        geometryDesc.Triangles.VertexCount = desc.vertexCount;
-        geometryDesc.Triangles.VertexBuffer.StartAddress = vertexBuffer->buffer->GetGPUVirtualAddress() + desc.vertexBufferStartOffset;
-        geometryDesc.Triangles.VertexBuffer.StrideInBytes = desc.vertexStride;
+        std::vector<D3D12_RAYTRACING_GEOMETRY_DESC> geometryDescs(desc.geometriesCount);
+        for (size_t i = 0; i < desc.geometriesCount; ++i) {
+            const BLASGeometryDesc& geometry = desc.geometries[i];
+            auto* indexBuffer = static_cast<D3D12Buffer*>(geometry.indexBuffer);
+            auto* vertexBuffer = static_cast<D3D12Buffer*>(geometry.vertexBuffer);
+            auto* transform = static_cast<D3D12Buffer*>(geometry.transformBuffer);
+
+            D3D12_RAYTRACING_GEOMETRY_DESC& geometryDesc = geometryDescs[i];
+            geometryDesc.Type = D3D12_RAYTRACING_GEOMETRY_TYPE_TRIANGLES;
+            geometryDesc.Flags = geometry.opaque ? D3D12_RAYTRACING_GEOMETRY_FLAG_OPAQUE : D3D12_RAYTRACING_GEOMETRY_FLAG_NONE;
+            geometryDesc.Triangles.IndexBuffer = indexBuffer ? indexBuffer->buffer->GetGPUVirtualAddress() + geometry.indexBufferStartOffset : 0;
+            geometryDesc.Triangles.IndexCount = indexBuffer ? geometry.indexCount : 0;
+            geometryDesc.Triangles.IndexFormat = indexBuffer ? Convert::ToDXGIFormat(geometry.indexFormat) : DXGI_FORMAT_UNKNOWN;
+            geometryDesc.Triangles.Transform3x4 = transform ? transform->buffer->GetGPUVirtualAddress() + geometry.transformBufferStartOffset : 0;
+            geometryDesc.Triangles.VertexFormat = Convert::ToDXGIFormat(geometry.vertexFormat);
+            geometryDesc.Triangles.VertexCount = geometry.vertexCount;
+            geometryDesc.Triangles.VertexBuffer.StartAddress = vertexBuffer->buffer->GetGPUVirtualAddress() + geometry.vertexBufferStartOffset;
+            geometryDesc.Triangles.VertexBuffer.StrideInBytes = geometry.vertexStride;
+        }
 
         D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS inputsDesc = {};
         inputsDesc.DescsLayout = D3D12_ELEMENTS_LAYOUT_ARRAY;
         inputsDesc.Flags = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_PREFER_FAST_TRACE |
                            D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_ALLOW_COMPACTION;
-        inputsDesc.NumDescs = 1;
+        inputsDesc.NumDescs = static_cast<UINT>(geometryDescs.size());
         inputsDesc.Type = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL;
-        inputsDesc.pGeometryDescs = &geometryDesc;
+        inputsDesc.pGeometryDescs = geometryDescs.data();
 
         D3D12_RAYTRACING_ACCELERATION_STRUCTURE_PREBUILD_INFO info = {};
         m_Device->GetRaytracingAccelerationStructurePrebuildInfo(&inputsDesc, &info);
 
         size_t ASSize = RHINO_CEIL_TO_POWER_OF_TWO(info.ResultDataMaxSizeInBytes, D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BYTE_ALIGNMENT);
-        {
-            D3D12_HEAP_PROPERTIES heapProperties{};
-            heapProperties.Type = D3D12_HEAP_TYPE_DEFAULT;
-            heapProperties.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
-            heapProperties.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
-
-            D3D12_RESOURCE_DESC resourceDesc{};
-            resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
-            resourceDesc.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
-            resourceDesc.Width = ASSize;
-            resourceDesc.Height = 1;
-            resourceDesc.DepthOrArraySize = 1;
-            resourceDesc.MipLevels = 1;
-            resourceDesc.Format = DXGI_FORMAT_UNKNOWN;
-            resourceDesc.SampleDesc.Count = 1;
-            resourceDesc.SampleDesc.Quality = 0;
-            resourceDesc.Flags = D3D12_RESOURCE_FLAG_RAYTRACING_ACCELERATION_STRUCTURE | D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
-            resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
-
-            RHINO_D3DS(m_Device->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &resourceDesc,
-                                                         D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE, nullptr,
-                                                         IID_PPV_ARGS(&result->buffer)));
-            RHINO_GPU_DEBUG(SetDebugName(result->buffer, name));
-        }
+        result->buffer = CreateASBuffer(ASSize, name);
 
         D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC buildDesc = {};
         buildDesc.DestAccelerationStructureData = result->buffer->GetGPUVirtualAddress();
         buildDesc.Inputs = inputsDesc;
-        buildDesc.ScratchAccelerationStructureData = scratch->buffer->GetGPUVirtualAddress() + scratchBufferStartOffset;
-
-        //TODO: retrieve compacted size and repack
-        // D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_DESC postBuildInfoDesc = {};
-        // postBuildInfoDesc.DestBuffer = postBuildDataBuffer;
-        // postBuildInfoDesc.InfoType = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE;
-        // cmd->BuildRaytracingAccelerationStructure(&buildDesc, 1, &postBuildInfoDesc);
+        buildDesc.ScratchAccelerationStructureData = scratchAddress;
 
         m_Cmd->BuildRaytracingAccelerationStructure(&buildDesc, 0, nullptr);
+        *outScratchSizeInBytes = RHINO_CEIL_TO_POWER_OF_TWO(info.ScratchDataSizeInBytes, D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BYTE_ALIGNMENT);
         return result;
     }
 
-    TLAS* D3D12CommandList::BuildTLAS(const TLASDesc& desc, Buffer* scratchBuffer, size_t scratchBufferStartOffset,
-                                      const char* name) noexcept {
-        auto* scratch = static_cast<D3D12Buffer*>(scratchBuffer);
+    void D3D12CommandList::QueryBLASCompactedSizes(size_t count, BLAS* const* blases) noexcept {
+        EmitBLASPostbuildInfo(count, blases, D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE,
+                              sizeof(D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE_DESC), &D3D12BLAS::compactedSizeQuery,
+                              "BLAS Compacted Sizes");
+    }
+
+    void D3D12CommandList::QueryBLASSerializedSizes(size_t count, BLAS* const* blases) noexcept {
+        EmitBLASPostbuildInfo(count, blases, D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_SERIALIZATION,
+                              sizeof(D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_SERIALIZATION_DESC), &D3D12BLAS::serializedSizeQuery,
+                              "BLAS Serialized Sizes");
+    }
 
-        auto result = new D3D12TLAS{};
-
-        const size_t instancesSize = desc.blasInstancesCount * sizeof(D3D12_RAYTRACING_INSTANCE_DESC);
-        ID3D12Resource* blasInstancesCPU = CreateStagingBuffer(instancesSize, D3D12_HEAP_TYPE_UPLOAD, D3D12_RESOURCE_STATE_COPY_SOURCE);
-        RHINO_GPU_DEBUG(SetDebugName(blasInstancesCPU, "BLAS Intances CPU Staging"));
-        ID3D12Resource* blasInstancesGPU = CreateStagingBuffer(instancesSize, D3D12_HEAP_TYPE_DEFAULT, D3D12_RESOURCE_STATE_COMMON);
-        RHINO_GPU_DEBUG(SetDebugName(blasInstancesGPU, "BLAS Intances GPU Staging"));
-        D3D12_RAYTRACING_INSTANCE_DESC* mappedData = nullptr;
-        blasInstancesCPU->Map(0, nullptr, reinterpret_cast<void**>(&mappedData));
-        for (size_t i = 0; i < desc.blasInstancesCount; ++i) {
-            const BLASInstanceDesc& instanceDesc = desc.blasInstances[i];
-            auto* d3d12BLAS = static_cast<D3D12BLAS*>(instanceDesc.blas);
-            D3D12_RAYTRACING_INSTANCE_DESC& mappedInstanceDesc = mappedData[i];
-            mappedInstanceDesc.Flags = D3D12_RAYTRACING_INSTANCE_FLAG_NONE;
-            mappedInstanceDesc.InstanceID = instanceDesc.instanceID;
-            mappedInstanceDesc.InstanceMask = instanceDesc.instanceMask;
-            mappedInstanceDesc.AccelerationStructure = d3d12BLAS->buffer->GetGPUVirtualAddress();
-            memcpy(mappedInstanceDesc.Transform, instanceDesc.transform, sizeof(instanceDesc.transform));
-            mappedInstanceDesc.InstanceContributionToHitGroupIndex = 0; //TODO: <- figure out wtf is that
+    void D3D12CommandList::EmitBLASPostbuildInfo(size_t count, BLAS* const* blases,
+                                                 D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_TYPE infoType, size_t infoSizeInBytes,
+                                                 D3D12ASPostbuildInfoQuery D3D12BLAS::*query, const char* name) noexcept {
+        if (count == 0) {
+            return;
         }
-        blasInstancesCPU->Unmap(0, nullptr);
-        m_Cmd->CopyBufferRegion(blasInstancesGPU, 0, blasInstancesCPU, 0, instancesSize);
+
+        const size_t sizesBufferSize = count * infoSizeInBytes;
+        ID3D12Resource* sizesGPU = CreateStagingBuffer(sizesBufferSize, D3D12_HEAP_TYPE_DEFAULT, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+        RHINO_GPU_DEBUG(SetDebugName(sizesGPU, std::string{name} + " GPU"));
+        // Shared by all queried BLASes, each of them holds a reference.
+        ID3D12Resource* sizesReadback = CreateStagingBuffer(sizesBufferSize, D3D12_HEAP_TYPE_READBACK, D3D12_RESOURCE_STATE_COPY_DEST);
+        RHINO_GPU_DEBUG(SetDebugName(sizesReadback, std::string{name} + " Readback"));
+
+        std::vector<D3D12_GPU_VIRTUAL_ADDRESS> addresses(count);
+        std::vector<D3D12_RESOURCE_BARRIER> buildBarriers(count);
+        for (size_t i = 0; i < count; ++i) {
+            auto* d3d12BLAS = static_cast<D3D12BLAS*>(blases[i]);
+            addresses[i] = d3d12BLAS->buffer->GetGPUVirtualAddress();
+
+            buildBarriers[i].Type = D3D12_RESOURCE_BARRIER_TYPE_UAV;
+            buildBarriers[i].UAV.pResource = d3d12BLAS->buffer;
+
+            (d3d12BLAS->*query).Reset(sizesReadback, i * infoSizeInBytes, m_Fence, m_FenceNextVal);
+        }
+        sizesReadback->Release();
+
+        // Builds have to be finished before their postbuild info is emitted.
+        m_Cmd->ResourceBarrier(static_cast<UINT>(count), buildBarriers.data());
+
+        D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_DESC postBuildInfoDesc{};
+        postBuildInfoDesc.DestBuffer = sizesGPU->GetGPUVirtualAddress();
+        postBuildInfoDesc.InfoType = infoType;
+        m_Cmd->EmitRaytracingAccelerationStructurePostbuildInfo(&postBuildInfoDesc, static_cast<UINT>(count), addresses.data());
 
         D3D12_RESOURCE_BARRIER barrier{};
         barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-        barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
-        barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
+        barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
+        barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_COPY_SOURCE;
         barrier.Transition.Subresource = 0;
-        barrier.Transition.pResource = blasInstancesGPU;
+        barrier.Transition.pResource = sizesGPU;
         m_Cmd->ResourceBarrier(1, &barrier);
 
-        D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS inputsDesc{};
-        inputsDesc.Type = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL;
-        inputsDesc.DescsLayout = D3D12_ELEMENTS_LAYOUT_ARRAY;
-        inputsDesc.Flags = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_PREFER_FAST_TRACE;
-        inputsDesc.NumDescs = desc.blasInstancesCount;
-        inputsDesc.InstanceDescs = blasInstancesGPU->GetGPUVirtualAddress();
+        m_Cmd->CopyBufferRegion(sizesReadback, 0, sizesGPU, 0, sizesBufferSize);
+        m_GarbageCollector->AddGarbage(sizesGPU, m_Fence, m_FenceNextVal);
+    }
+
+    void D3D12CommandList::CompactBLASes(size_t count, BLAS* const* blases, const char* name, BLAS** outCompacted) noexcept {
+        for (size_t i = 0; i < count; ++i) {
+            auto* source = static_cast<D3D12BLAS*>(blases[i]);
+            size_t compactedSize = 0;
+            const bool sizeReady = source->compactedSizeQuery.GetSize(&compactedSize);
+            assert(sizeReady && "BLAS compacted size is not read back yet.");
+            if (!sizeReady) {
+                compactedSize = source->buffer->GetDesc().Width;
+            }
+
+            auto* result = new D3D12BLAS{};
+            result->buffer = CreateASBuffer(RHINO_CEIL_TO_POWER_OF_TWO(compactedSize, D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BYTE_ALIGNMENT),
+                                            name);
+            m_Cmd->CopyRaytracingAccelerationStructure(result->buffer->GetGPUVirtualAddress(), source->buffer->GetGPUVirtualAddress(),
+                                                       D3D12_RAYTRACING_ACCELERATION_STRUCTURE_COPY_MODE_COMPACT);
+
+            m_CompactedSources.push_back(source);
+            outCompacted[i] = result;
+        }
+    }
+
+    void D3D12CommandList::SerializeBLAS(BLAS* blas, Buffer* dstBuffer, size_t dstBufferStartOffset) noexcept {
+        auto* d3d12BLAS = static_cast<D3D12BLAS*>(blas);
+        auto* dst = static_cast<D3D12Buffer*>(dstBuffer);
+        size_t serializedSize = 0;
+        const bool sizeReady = d3d12BLAS->serializedSizeQuery.GetSize(&serializedSize);
+        assert(sizeReady && "BLAS serialized size is not read back yet.");
+        if (!sizeReady) {
+            return;
+        }
+
+        // Serialization destination has to be in UAV state, so blob goes to readback buffer through intermediate one.
+        ID3D12Resource* blobGPU = CreateStagingBuffer(serializedSize, D3D12_HEAP_TYPE_DEFAULT, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+        RHINO_GPU_DEBUG(SetDebugName(blobGPU, "Serialized BLAS GPU"));
+
+        // Build has to be finished before the structure is serialized.
+        D3D12_RESOURCE_BARRIER buildBarrier{};
+        buildBarrier.Type = D3D12_RESOURCE_BARRIER_TYPE_UAV;
+        buildBarrier.UAV.pResource = d3d12BLAS->buffer;
+        m_Cmd->ResourceBarrier(1, &buildBarrier);
+
+        m_Cmd->CopyRaytracingAccelerationStructure(blobGPU->GetGPUVirtualAddress(), d3d12BLAS->buffer->GetGPUVirtualAddress(),
+                                                   D3D12_RAYTRACING_ACCELERATION_STRUCTURE_COPY_MODE_SERIALIZE);
+
+        D3D12_RESOURCE_BARRIER barrier{};
+        barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+        barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
+        barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_COPY_SOURCE;
+        barrier.Transition.Subresource = 0;
+        barrier.Transition.pResource = blobGPU;
+        m_Cmd->ResourceBarrier(1, &barrier);
+
+        m_Cmd->CopyBufferRegion(dst->buffer, dstBufferStartOffset, blobGPU, 0, serializedSize);
+        m_GarbageCollector->AddGarbage(blobGPU, m_Fence, m_FenceNextVal);
+    }
+
+    BLAS* D3D12CommandList::DeserializeBLAS(const SerializedASInfo& info, Buffer* srcBuffer, size_t srcBufferStartOffset,
+                                            const char* name) noexcept {
+        if (!info.compatible) {
+            return nullptr;
+        }
+        auto* src = static_cast<D3D12Buffer*>(srcBuffer);
+        const D3D12_GPU_VIRTUAL_ADDRESS srcAddress = src->buffer->GetGPUVirtualAddress() + srcBufferStartOffset;
+        assert(srcAddress % D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BYTE_ALIGNMENT == 0 && "Serialized BLAS source is not aligned.");
+
+        auto* result = new D3D12BLAS{};
+        result->buffer = CreateASBuffer(
+                RHINO_CEIL_TO_POWER_OF_TWO(info.deserializedSizeInBytes, D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BYTE_ALIGNMENT), name);
+        m_Cmd->CopyRaytracingAccelerationStructure(result->buffer->GetGPUVirtualAddress(), srcAddress,
+                                                   D3D12_RAYTRACING_ACCELERATION_STRUCTURE_COPY_MODE_DESERIALIZE);
+        return result;
+    }
+
+    TLAS* D3D12CommandList::BuildTLAS(const TLASDesc& desc, Buffer* scratchBuffer, size_t scratchBufferStartOffset,
+                                      const char* name) noexcept {
+        auto* scratch = static_cast<D3D12Buffer*>(scratchBuffer);
+
+        auto* result = new D3D12TLAS{};
+        result->allowUpdate = desc.allowUpdate;
+        result->instancesCount = desc.blasInstancesCount;
+        D3D12TLASInstanceBuffer* instanceBuffer = AcquireTLASInstanceBuffer(result);
+        WriteTLASInstances(instanceBuffer, desc);
+
+        D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS inputsDesc = GetTLASInputs(instanceBuffer, desc);
 
         D3D12_RAYTRACING_ACCELERATION_STRUCTURE_PREBUILD_INFO info = {};
         m_Device->GetRaytracingAccelerationStructurePrebuildInfo(&inputsDesc, &info);
 
         size_t ASSize = RHINO_CEIL_TO_POWER_OF_TWO(info.ResultDataMaxSizeInBytes, D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BYTE_ALIGNMENT);
-        {
-            D3D12_HEAP_PROPERTIES heapProperties{};
-            heapProperties.Type = D3D12_HEAP_TYPE_DEFAULT;
-            heapProperties.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
-            heapProperties.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
-
-            D3D12_RESOURCE_DESC resourceDesc{};
-            resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
-            resourceDesc.Alignment = 0;
-            resourceDesc.Width = ASSize;
-            resourceDesc.Height = 1;
-            resourceDesc.DepthOrArraySize = 1;
-            resourceDesc.MipLevels = 1;
-            resourceDesc.Format = DXGI_FORMAT_UNKNOWN;
-            resourceDesc.SampleDesc.Count = 1;
-            resourceDesc.SampleDesc.Quality = 0;
-            resourceDesc.Flags = D3D12_RESOURCE_FLAG_RAYTRACING_ACCELERATION_STRUCTURE | D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
-            resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
-
-            RHINO_D3DS(m_Device->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &resourceDesc,
-                                                         D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE, nullptr,
-                                                         IID_PPV_ARGS(&result->buffer)));
-            RHINO_GPU_DEBUG(SetDebugName(result->buffer, name));
-        }
+        result->buffer = CreateASBuffer(ASSize, name);
 
         D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC buildDesc = {};
         buildDesc.DestAccelerationStructureData = result->buffer->GetGPUVirtualAddress();
@@ -311,9 +448,116 @@ namespace RHINO::APID3D12 {
         buildDesc.ScratchAccelerationStructureData = scratch->buffer->GetGPUVirtualAddress() + scratchBufferStartOffset;
 
         m_Cmd->BuildRaytracingAccelerationStructure(&buildDesc, 0, nullptr);
+        return result;
+    }
+
+    void D3D12CommandList::UpdateTLAS(TLAS* tlas, const TLASDesc& desc, Buffer* scratchBuffer, size_t scratchBufferStartOffset) noexcept {
+        auto* d3d12TLAS = static_cast<D3D12TLAS*>(tlas);
+        auto* scratch = static_cast<D3D12Buffer*>(scratchBuffer);
+        assert(d3d12TLAS->allowUpdate && "TLAS was built without allowUpdate.");
+        assert(d3d12TLAS->instancesCount == desc.blasInstancesCount && "TLAS update can't change instances count.");
+
+        // Instances are written at record time, so they go to a buffer that previously recorded builds do not read.
+        D3D12TLASInstanceBuffer* instanceBuffer = AcquireTLASInstanceBuffer(d3d12TLAS);
+        WriteTLASInstances(instanceBuffer, desc);
+
+        // Orders update after AS build or update of this TLAS recorded earlier in the same command list.
+        D3D12_RESOURCE_BARRIER barrier{};
+        barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_UAV;
+        barrier.UAV.pResource = d3d12TLAS->buffer;
+        m_Cmd->ResourceBarrier(1, &barrier);
+
+        D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC buildDesc = {};
+        buildDesc.DestAccelerationStructureData = d3d12TLAS->buffer->GetGPUVirtualAddress();
+        buildDesc.SourceAccelerationStructureData = d3d12TLAS->buffer->GetGPUVirtualAddress();
+        buildDesc.Inputs = GetTLASInputs(instanceBuffer, desc);
+        buildDesc.Inputs.Flags |= D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_PERFORM_UPDATE;
+        buildDesc.ScratchAccelerationStructureData = scratch->buffer->GetGPUVirtualAddress() + scratchBufferStartOffset;
+
+        m_Cmd->BuildRaytracingAccelerationStructure(&buildDesc, 0, nullptr);
+    }
+
+    D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS D3D12CommandList::GetTLASInputs(D3D12TLASInstanceBuffer* instanceBuffer,
+                                                                                          const TLASDesc& desc) noexcept {
+        D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS result{};
+        result.Type = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL;
+        result.DescsLayout = D3D12_ELEMENTS_LAYOUT_ARRAY;
+        result.Flags = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_PREFER_FAST_TRACE;
+        if (desc.allowUpdate) {
+            result.Flags |= D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_ALLOW_UPDATE;
+        }
+        result.NumDescs = desc.blasInstancesCount;
+        result.InstanceDescs = instanceBuffer->buffer->GetGPUVirtualAddress();
+        return result;
+    }
+
+    D3D12TLASInstanceBuffer* D3D12CommandList::AcquireTLASInstanceBuffer(D3D12TLAS* tlas) noexcept {
+        D3D12TLASInstanceBuffer* result = nullptr;
+        for (D3D12TLASInstanceBuffer* instanceBuffer : tlas->instanceBuffers) {
+            if (instanceBuffer->IsIdle()) {
+                result = instanceBuffer;
+                break;
+            }
+        }
+        if (!result) {
+            result = new D3D12TLASInstanceBuffer{};
+            const size_t instancesSize = std::max<size_t>(tlas->instancesCount, 1) * sizeof(D3D12_RAYTRACING_INSTANCE_DESC);
+            result->buffer = CreateStagingBuffer(instancesSize, D3D12_HEAP_TYPE_UPLOAD, D3D12_RESOURCE_STATE_GENERIC_READ);
+            RHINO_GPU_DEBUG(SetDebugName(result->buffer, "BLAS Instances"));
+            const D3D12_RANGE readRange{0, 0};
+            result->buffer->Map(0, &readRange, reinterpret_cast<void**>(&result->mapped));
+            // Forces the first write of every instance.
+            result->instances.resize(tlas->instancesCount);
+            memset(result->instances.data(), 0xFF, result->instances.size() * sizeof(D3D12_RAYTRACING_INSTANCE_DESC));
+            tlas->instanceBuffers.push_back(result);
+        }
+
+        // Busy until the next submission of this command list completes.
+        if (result->lastUseFence != m_Fence) {
+            m_Fence->AddRef();
+            if (result->lastUseFence) {
+                result->lastUseFence->Release();
+            }
+            result->lastUseFence = m_Fence;
+        }
+        result->lastUseFenceValue = m_FenceNextVal;
+        return result;
+    }
+
+    void D3D12CommandList::WriteTLASInstances(D3D12TLASInstanceBuffer* instanceBuffer, const TLASDesc& desc) noexcept {
+        static_assert(sizeof(D3D12_RAYTRACING_INSTANCE_DESC) == sizeof(PackedASInstance));
+        static_assert(offsetof(D3D12_RAYTRACING_INSTANCE_DESC, AccelerationStructure) == offsetof(PackedASInstance, blasAddress));
+
+        // Upload heap is write combined, so instances are compared against the host copy instead.
+        // Instance flags and hit group contribution are always 0.
+        PackASInstances(desc.blasInstances, desc.blasInstancesCount, reinterpret_cast<PackedASInstance*>(instanceBuffer->instances.data()),
+                        reinterpret_cast<PackedASInstance*>(instanceBuffer->mapped),
+                        [](BLAS* blas) { return static_cast<D3D12BLAS*>(blas)->buffer->GetGPUVirtualAddress(); });
+    }
+
+    ID3D12Resource* D3D12CommandList::CreateASBuffer(size_t size, const char* name) noexcept {
+        ID3D12Resource* result = nullptr;
+        D3D12_HEAP_PROPERTIES heapProperties{};
+        heapProperties.Type = D3D12_HEAP_TYPE_DEFAULT;
+        heapProperties.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+        heapProperties.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+
+        D3D12_RESOURCE_DESC resourceDesc{};
+        resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+        resourceDesc.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+        resourceDesc.Width = size;
+        resourceDesc.Height = 1;
+        resourceDesc.DepthOrArraySize = 1;
+        resourceDesc.MipLevels = 1;
+        resourceDesc.Format = DXGI_FORMAT_UNKNOWN;
+        resourceDesc.SampleDesc.Count = 1;
+        resourceDesc.SampleDesc.Quality = 0;
+        resourceDesc.Flags = D3D12_RESOURCE_FLAG_RAYTRACING_ACCELERATION_STRUCTURE | D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
+        resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
 
-        m_GarbageCollector->AddGarbage(blasInstancesCPU, m_Fence, m_FenceNextVal);
-        m_GarbageCollector->AddGarbage(blasInstancesGPU, m_Fence, m_FenceNextVal);
+        RHINO_D3DS(m_Device->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &resourceDesc,
+                                                     D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE, nullptr, IID_PPV_ARGS(&result)));
+        RHINO_GPU_DEBUG(SetDebugName(result, name));
         return result;
     }
 
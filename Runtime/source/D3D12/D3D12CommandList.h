@@ -12,11 +12,17 @@ namespace RHINO::APID3D12 {
         ID3D12CommandAllocator* m_Allocator = nullptr;
         ID3D12GraphicsCommandList4* m_Cmd = nullptr;
         ID3D12Fence* m_Fence = nullptr;
-        size_t m_FenceNextVal = 0;
+        // Fence is created with 0, so the first submission signals 1.
+        size_t m_FenceNextVal = 1;
+        // Shader visible heaps referenced until this command list is executed.
+        std::vector<ID3D12DescriptorHeap*> m_ReferencedHeaps{};
+        // Compacted BLASes sources, owned by the caller until this command list is submitted, retired on submission.
+        std::vector<D3D12BLAS*> m_CompactedSources{};
 
         D3D12GarbageCollector* m_GarbageCollector = nullptr;
 
         D3D12RootSignature* m_CurRootSignature = nullptr;
+        D3D12ComputePSO* m_CurComputePSO = nullptr;
 
     public:
         void Initialize(const char* name, ID3D12Device5* device, D3D12GarbageCollector* garbageCollector) noexcept;
@@ -24,11 +30,14 @@ namespace RHINO::APID3D12 {
         void SumbitToQueue(ID3D12CommandQueue* queue) noexcept;
 
     public:
+        void Reset() noexcept final;
         void CopyBuffer(Buffer* src, Buffer* dst, size_t srcOffset, size_t dstOffset, size_t size) noexcept final;
         void SetComputePSO(ComputePSO* pso) noexcept final;
+        bool TrySetComputePSO(ComputePSO* pso) noexcept final;
         void SetRootSignature(RootSignature* rootSignature) noexcept final;
         void SetHeap(DescriptorHeap* CBVSRVUAVHeap, DescriptorHeap* samplerHeap) noexcept final;
         void Dispatch(const DispatchDesc& desc) noexcept final;
+        void DispatchThreads(size_t threadsX, size_t threadsY, size_t threadsZ) noexcept final;
         void DispatchRays(const DispatchRaysDesc& desc) noexcept final;
         void Draw() noexcept final;
         void ResourceBarrier(const ResourceBarrierDesc& desc) noexcept final;
@@ -36,10 +45,33 @@ namespace RHINO::APID3D12 {
     public:
         void BuildRTPSO(RTPSO* pso) noexcept final;
         BLAS* BuildBLAS(const BLASDesc& desc, Buffer* scratchBuffer, size_t scratchBufferStartOffset, const char* name) noexcept final;
+        void BuildBLASes(size_t count, const BLASDesc* descs, Buffer* scratchBuffer, size_t scratchBufferStartOffset, const char* name,
+                         BLAS** outBLASes) noexcept final;
+        void QueryBLASCompactedSizes(size_t count, BLAS* const* blases) noexcept final;
+        void CompactBLASes(size_t count, BLAS* const* blases, const char* name, BLAS** outCompacted) noexcept final;
+        void QueryBLASSerializedSizes(size_t count, BLAS* const* blases) noexcept final;
+        void SerializeBLAS(BLAS* blas, Buffer* dstBuffer, size_t dstBufferStartOffset) noexcept final;
+        BLAS* DeserializeBLAS(const SerializedASInfo& info, Buffer* srcBuffer, size_t srcBufferStartOffset, const char* name) noexcept final;
         TLAS* BuildTLAS(const TLASDesc& desc, Buffer* scratchBuffer, size_t scratchBufferStartOffset, const char* name) noexcept final;
+        void UpdateTLAS(TLAS* tlas, const TLASDesc& desc, Buffer* scratchBuffer, size_t scratchBufferStartOffset) noexcept final;
 
     private:
         ID3D12Resource* CreateStagingBuffer(size_t size, D3D12_HEAP_TYPE heap, D3D12_RESOURCE_STATES initialState) noexcept;
+        ID3D12Resource* CreateASBuffer(size_t size, const char* name) noexcept;
+        // Emits postbuild info of infoType to readback buffer shared by BLASes, each BLAS gets its record in query member.
+        void EmitBLASPostbuildInfo(size_t count, BLAS* const* blases, D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_TYPE infoType,
+                                   size_t infoSizeInBytes, D3D12ASPostbuildInfoQuery D3D12BLAS::*query, const char* name) noexcept;
+        D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS GetTLASInputs(D3D12TLASInstanceBuffer* instanceBuffer,
+                                                                           const TLASDesc& desc) noexcept;
+        // Returns instance buffer of TLAS no recorded or executing build reads, marked as used by this command list.
+        D3D12TLASInstanceBuffer* AcquireTLASInstanceBuffer(D3D12TLAS* tlas) noexcept;
+        // Writes only instances that differ from the ones written to this buffer before.
+        void WriteTLASInstances(D3D12TLASInstanceBuffer* instanceBuffer, const TLASDesc& desc) noexcept;
+        // Keeps bound heap alive until this command list is executed, even if the heap grows meanwhile.
+        void ReferenceHeap(ID3D12DescriptorHeap* heap) noexcept;
+        // Returns scratch size used by the build, aligned for the next build start.
+        D3D12BLAS* RecordBLASBuild(const BLASDesc& desc, D3D12_GPU_VIRTUAL_ADDRESS scratchAddress, const char* name,
+                                   size_t* outScratchSizeInBytes) noexcept;
     };
 } // namespace RHINO::APID3D12
 
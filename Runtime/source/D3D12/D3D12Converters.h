@@ -109,6 +109,8 @@ namespace RHINO::APID3D12::Convert {
     inline D3D12_DESCRIPTOR_HEAP_TYPE ToD3D12DescriptorHeapType(DescriptorHeapType type) noexcept {
         switch (type) {
             case DescriptorHeapType::SRV_CBV_UAV:
+            case DescriptorHeapType::SRV_CBV_UAV_BuffersOnly:
+            case DescriptorHeapType::SRV_UAV_TexturesOnly:
                 return D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
             case DescriptorHeapType::RTV:
                 return D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
@@ -3,6 +3,7 @@
 #include "D3D12DescriptorHeap.h"
 #include "D3D12BackendTypes.h"
 #include "D3D12Converters.h"
+#include "D3D12Utils.h"
 
 namespace RHINO::APID3D12 {
     void D3D12DescriptorHeap::WriteSRV(const WriteBufferDescriptorDesc& desc) noexcept {
@@ -140,6 +141,37 @@ namespace RHINO::APID3D12 {
         device->CopyDescriptorsSimple(1, GPUHeapCPUHandle, CPUHeapCPUHandle, D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER);
     }
 
+    void D3D12DescriptorHeap::Grow(size_t newDescriptorsCount) noexcept {
+        if (newDescriptorsCount <= descriptorsCount) {
+            return;
+        }
+
+        ID3D12DescriptorHeap* newCPUDescriptorHeap = nullptr;
+        ID3D12DescriptorHeap* newGPUDescriptorHeap = nullptr;
+
+        D3D12_DESCRIPTOR_HEAP_DESC heapDesc = GPUDescriptorHeap->GetDesc();
+        heapDesc.NumDescriptors = newDescriptorsCount;
+        RHINO_D3DS(device->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&newGPUDescriptorHeap)));
+        heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+        RHINO_D3DS(device->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&newCPUDescriptorHeap)));
+
+        const D3D12_CPU_DESCRIPTOR_HANDLE newCPUHeapCPUStartHandle = newCPUDescriptorHeap->GetCPUDescriptorHandleForHeapStart();
+        const D3D12_CPU_DESCRIPTOR_HANDLE newGPUHeapCPUStartHandle = newGPUDescriptorHeap->GetCPUDescriptorHandleForHeapStart();
+        device->CopyDescriptorsSimple(descriptorsCount, newCPUHeapCPUStartHandle, CPUHeapCPUStartHandle, heapType);
+        device->CopyDescriptorsSimple(descriptorsCount, newGPUHeapCPUStartHandle, CPUHeapCPUStartHandle, heapType);
+
+        // Command lists recorded with the old shader visible heap hold their own references to it.
+        CPUDescriptorHeap->Release();
+        GPUDescriptorHeap->Release();
+
+        CPUDescriptorHeap = newCPUDescriptorHeap;
+        GPUDescriptorHeap = newGPUDescriptorHeap;
+        CPUHeapCPUStartHandle = newCPUHeapCPUStartHandle;
+        GPUHeapCPUStartHandle = newGPUHeapCPUStartHandle;
+        GPUHeapGPUStartHandle = newGPUDescriptorHeap->GetGPUDescriptorHandleForHeapStart();
+        descriptorsCount = newDescriptorsCount;
+    }
+
     void D3D12DescriptorHeap::Release() noexcept {
         CPUDescriptorHeap->Release();
         GPUDescriptorHeap->Release();
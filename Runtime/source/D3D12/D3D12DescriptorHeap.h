@@ -14,6 +14,7 @@ namespace RHINO::APID3D12 {
         void WriteUAV(const WriteTexture3DDescriptorDesc& desc) noexcept final;
         void WriteSRV(const WriteTLASDescriptorDesc& desc) noexcept final;
         void WriteSMP(Sampler* sampler, size_t offsetInHeap) noexcept final;
+        void Grow(size_t newDescriptorsCount) noexcept final;
     public:
         void Release() noexcept final;
 
@@ -24,6 +25,8 @@ namespace RHINO::APID3D12 {
 
         ID3D12DescriptorHeap* CPUDescriptorHeap = nullptr;
         ID3D12DescriptorHeap* GPUDescriptorHeap = nullptr;
+        D3D12_DESCRIPTOR_HEAP_TYPE heapType = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+        size_t descriptorsCount = 0;
         UINT descriptorHandleIncrementSize = 0;
         D3D12_CPU_DESCRIPTOR_HANDLE CPUHeapCPUStartHandle = {};
         D3D12_CPU_DESCRIPTOR_HANDLE GPUHeapCPUStartHandle = {};
@@ -4,24 +4,30 @@
 
 namespace RHINO::APID3D12 {
 
-    void D3D12GarbageCollector::AddGarbage(ID3D12Resource* resource, ID3D12Fence* fence, size_t completionValue) noexcept {
+    void D3D12GarbageCollector::AddGarbage(ID3D12Pageable* resource, ID3D12Fence* fence, size_t completionValue) noexcept {
         HANDLE cpuEvent = ::CreateEventEx(NULL, FALSE, FALSE, EVENT_ALL_ACCESS);
         fence->SetEventOnCompletion(completionValue, cpuEvent);
+        std::lock_guard lock{m_Mutex};
         m_TrackedItems.emplace_back(resource, cpuEvent);
     }
 
     void D3D12GarbageCollector::CollectGarbage() noexcept {
+        std::lock_guard lock{m_Mutex};
         auto i = m_TrackedItems.begin();
         while (i != m_TrackedItems.end()) {
             if (WaitForSingleObject(i->event, 0) == WAIT_OBJECT_0) {
                 i->resource->Release();
-                i = m_TrackedItems.erase(i);
                 CloseHandle(i->event);
+                i = m_TrackedItems.erase(i);
+            }
+            else {
+                ++i;
             }
         }
     }
 
     void D3D12GarbageCollector::Release() noexcept {
+        std::lock_guard lock{m_Mutex};
         for (auto& item: m_TrackedItems) {
             WaitForSingleObject(item.event, INFINITE);
             CloseHandle(item.event);
@@ -0,0 +1,90 @@
+#ifdef ENABLE_API_D3D12
+
+#include "D3D12SemaphoreWaiter.h"
+
+namespace RHINO::APID3D12 {
+    void D3D12SemaphoreWaiter::Initialize(ID3D12Device1* device) noexcept {
+        m_Device = device;
+        m_WakeEvent = ::CreateEventEx(NULL, NULL, 0, EVENT_ALL_ACCESS);
+        m_FencesEvent = ::CreateEventEx(NULL, NULL, 0, EVENT_ALL_ACCESS);
+
+        m_Stop = false;
+        m_Thread = std::thread{[this]() { WaiterLoop(); }};
+    }
+
+    void D3D12SemaphoreWaiter::AddCallback(ID3D12Fence* fence, uint64_t value, SemaphoreCallback callback, void* userData) noexcept {
+        {
+            std::lock_guard lock{m_Mutex};
+            m_Pending.emplace_back(fence, value, callback, userData);
+        }
+        SetEvent(m_WakeEvent);
+    }
+
+    void D3D12SemaphoreWaiter::Release() noexcept {
+        {
+            std::lock_guard lock{m_Mutex};
+            m_Stop = true;
+        }
+        SetEvent(m_WakeEvent);
+        if (m_Thread.joinable()) {
+            m_Thread.join();
+        }
+        m_Pending.clear();
+        CloseHandle(m_WakeEvent);
+        CloseHandle(m_FencesEvent);
+    }
+
+    void D3D12SemaphoreWaiter::WaiterLoop() noexcept {
+        std::vector<ID3D12Fence*> fences{};
+        std::vector<UINT64> values{};
+        std::vector<PendingCallback> ready{};
+
+        while (true) {
+            fences.clear();
+            values.clear();
+            {
+                std::lock_guard lock{m_Mutex};
+                if (m_Stop) {
+                    return;
+                }
+                for (const PendingCallback& pending : m_Pending) {
+                    fences.push_back(pending.fence);
+                    values.push_back(pending.value);
+                }
+            }
+
+            // Auto reset events. Wake event set after the snapshot above interrupts the wait.
+            // Fences event left from interrupted waits only causes an extra pass over pending list.
+            const HANDLE events[] = {m_WakeEvent, m_FencesEvent};
+            DWORD eventsCount = 1;
+            if (!fences.empty()) {
+                m_Device->SetEventOnMultipleFenceCompletion(fences.data(), values.data(), static_cast<UINT>(fences.size()),
+                                                            D3D12_MULTIPLE_FENCE_WAIT_FLAG_ANY, m_FencesEvent);
+                eventsCount = 2;
+            }
+            WaitForMultipleObjects(eventsCount, events, FALSE, INFINITE);
+
+            {
+                std::lock_guard lock{m_Mutex};
+                auto i = m_Pending.begin();
+                while (i != m_Pending.end()) {
+                    if (i->fence->GetCompletedValue() >= i->value) {
+                        ready.push_back(*i);
+                        i = m_Pending.erase(i);
+                    }
+                    else {
+                        ++i;
+                    }
+                }
+            }
+
+            // Called outside of the lock, so callbacks are free to register new ones.
+            for (const PendingCallback& pending : ready) {
+                pending.callback(pending.userData);
+            }
+            ready.clear();
+        }
+    }
+} // namespace RHINO::APID3D12
+
+#endif // ENABLE_API_D3D12
@@ -0,0 +1,40 @@
+#pragma once
+
+#ifdef ENABLE_API_D3D12
+
+namespace RHINO::APID3D12 {
+    /**
+     * Background thread calling callbacks when fences reach requested values.
+     * Sleeps on a single event set by SetEventOnMultipleFenceCompletion with ANY semantics over all pending values.
+     */
+    class D3D12SemaphoreWaiter {
+    private:
+        struct PendingCallback {
+            ID3D12Fence* fence;
+            uint64_t value;
+            SemaphoreCallback callback;
+            void* userData;
+        };
+
+    public:
+        void Initialize(ID3D12Device1* device) noexcept;
+        void AddCallback(ID3D12Fence* fence, uint64_t value, SemaphoreCallback callback, void* userData) noexcept;
+        // Stops waiter thread. Pending callbacks are dropped.
+        void Release() noexcept;
+
+    private:
+        void WaiterLoop() noexcept;
+
+    private:
+        ID3D12Device1* m_Device = nullptr;
+        std::mutex m_Mutex{};
+        std::list<PendingCallback> m_Pending{};
+        // Set from host to interrupt the wait when pending list changes.
+        HANDLE m_WakeEvent = nullptr;
+        HANDLE m_FencesEvent = nullptr;
+        bool m_Stop = false;
+        std::thread m_Thread{};
+    };
+} // namespace RHINO::APID3D12
+
+#endif // ENABLE_API_D3D12
@@ -1,4 +1,5 @@
 #include "DebugLayer.h"
+#include "FrameContextImpl.h"
 
 #ifdef WIN32
 #include <windows.h>
@@ -6,10 +7,10 @@
 
 namespace RHINO::DebugLayer {
     using namespace std::string_literals;
-    DebugLayer::DebugLayer(RHINOInterface* wrapped) noexcept : m_Wrapped(wrapped) {}
+    DebugLayer::DebugLayer(RHINOInterface* wrapped, BackendAPI backendApi) noexcept : m_Wrapped(wrapped), m_BackendAPI(backendApi) {}
 
-    void DebugLayer::Initialize() noexcept {
-        m_Wrapped->Initialize();
+    void DebugLayer::Initialize(const InitializeDesc& desc) noexcept {
+        m_Wrapped->Initialize(desc);
     }
 
     void DebugLayer::Release() noexcept {
@@ -68,6 +69,14 @@ namespace RHINO::DebugLayer {
         return result;
     }
 
+    FrameContext* DebugLayer::CreateFrameContext(const FrameContextDesc& desc) noexcept {
+        if (!desc.framesInFlight) {
+            DB("FrameContextDesc::framesInFlight must be at least 1"s);
+        }
+        // Created on top of debug layer so that frame context calls are validated too.
+        return new FrameContextImpl{this, desc};
+    }
+
     RTPSO* DebugLayer::CreateSCARRTPSO(const void* scar, uint32_t sizeInBytes, const RTPSODesc& desc) noexcept {
         auto* result = m_Wrapped->CreateSCARRTPSO(scar, sizeInBytes, desc);
         return result;
@@ -81,10 +90,20 @@ namespace RHINO::DebugLayer {
 
     RootSignature* DebugLayer::SerializeRootSignature(const RootSignatureDesc& desc) noexcept {
         std::set<size_t> usedSpaces{};
+        DescriptorHeapType resourceSpacesType = DescriptorHeapType::Count;
         for (size_t space = 0; space < desc.spacesCount; ++space) {
             if (usedSpaces.contains(desc.spacesDescs[space].space)) {
                 DB("Redefined descrioptor space ["s + std::to_string(desc.spacesDescs[space].space) + "]."s);
             }
+            // All SRV/UAV/CBV spaces are bound from the single heap passed to CommandList::SetHeap.
+            const DescriptorHeapType spaceType = desc.spacesDescs[space].spaceType;
+            if (spaceType != DescriptorHeapType::Sampler) {
+                if (resourceSpacesType != DescriptorHeapType::Count && resourceSpacesType != spaceType) {
+                    DB("Mixed SRV/UAV/CBV descriptor space types. All of them are bound from one heap, so they must have one type. Space ["s +
+                       std::to_string(space) + "] type ["s + EtoS(spaceType) + "]"s);
+                }
+                resourceSpacesType = spaceType;
+            }
             usedSpaces.insert(desc.spacesDescs[space].space);
             if (desc.spacesDescs[space].rangeDescCount) {
                 const bool isSampler = desc.spacesDescs[space].rangeDescs[0].rangeType == DescriptorRangeType::Sampler;
@@ -108,16 +127,67 @@ namespace RHINO::DebugLayer {
     }
 
     ComputePSO* DebugLayer::CompileComputePSO(const ComputePSODesc& desc) noexcept {
+        ValidateSpecializationConstants(desc.specializationConstantsCount, desc.debugName);
         auto* result = m_Wrapped->CompileComputePSO(desc);
+        if (!result) {
+            DW("Failed to compile compute PSO '"s + desc.debugName + "'"s);
+            return nullptr;
+        }
+
+        auto* meta = new ComputePSOMeta{DLResourceType::ComputePSO, desc.debugName};
+        m_ResourcesMeta[result] = DebugMetadata{.meta = meta};
+
+        return result;
+    }
+    ComputePSO* DebugLayer::CompileComputePSOAsync(const ComputePSODesc& desc) noexcept {
+        ValidateSpecializationConstants(desc.specializationConstantsCount, desc.debugName);
+        auto* result = m_Wrapped->CompileComputePSOAsync(desc);
+        if (!result) {
+            DW("Failed to compile compute PSO '"s + desc.debugName + "'"s);
+            return nullptr;
+        }
 
         auto* meta = new ComputePSOMeta{DLResourceType::ComputePSO, desc.debugName};
         m_ResourcesMeta[result] = DebugMetadata{.meta = meta};
 
         return result;
     }
+
+    ComputePSO* DebugLayer::CompileSCARComputePSOAsync(const void* scar, uint32_t sizeInBytes, RootSignature* rootSignature,
+                                                       const char* debugName, size_t specializationConstantsCount,
+                                                       const SpecializationConstant* specializationConstants) noexcept {
+        ValidateSpecializationConstants(specializationConstantsCount, debugName);
+        auto* result = m_Wrapped->CompileSCARComputePSOAsync(scar, sizeInBytes, rootSignature, debugName, specializationConstantsCount,
+                                                             specializationConstants);
+        return result;
+    }
+
+    void DebugLayer::CompileComputePSOs(size_t count, const ComputePSODesc* descs, ComputePSO** outPSOs) noexcept {
+        for (size_t i = 0; i < count; ++i) {
+            ValidateSpecializationConstants(descs[i].specializationConstantsCount, descs[i].debugName);
+        }
+        m_Wrapped->CompileComputePSOs(count, descs, outPSOs);
+
+        for (size_t i = 0; i < count; ++i) {
+            if (!outPSOs[i]) {
+                DW("Failed to compile compute PSO '"s + descs[i].debugName + "'"s);
+                continue;
+            }
+            auto* meta = new ComputePSOMeta{DLResourceType::ComputePSO, descs[i].debugName};
+            m_ResourcesMeta[outPSOs[i]] = DebugMetadata{.meta = meta};
+        }
+    }
+
+    bool DebugLayer::SavePSOCache() noexcept {
+        return m_Wrapped->SavePSOCache();
+    }
+
     ComputePSO* DebugLayer::CompileSCARComputePSO(const void* scar, uint32_t sizeInBytes, RootSignature* rootSignature,
-                                                  const char* debugName) noexcept {
-        auto* result = m_Wrapped->CompileSCARComputePSO(scar, sizeInBytes, rootSignature, debugName);
+                                                  const char* debugName, size_t specializationConstantsCount,
+                                                  const SpecializationConstant* specializationConstants) noexcept {
+        ValidateSpecializationConstants(specializationConstantsCount, debugName);
+        auto* result = m_Wrapped->CompileSCARComputePSO(scar, sizeInBytes, rootSignature, debugName, specializationConstantsCount,
+                                                        specializationConstants);
         return result;
     }
 
@@ -196,6 +266,14 @@ namespace RHINO::DebugLayer {
         return result;
     }
 
+    void DebugLayer::CopyDescriptors(DescriptorHeap* dstHeap, size_t dstOffset, DescriptorHeap* srcHeap, size_t srcOffset,
+                                     size_t count) noexcept {
+        if (dstHeap == srcHeap && dstOffset < srcOffset + count && srcOffset < dstOffset + count) {
+            DW("CopyDescriptors source and destination ranges overlap.");
+        }
+        m_Wrapped->CopyDescriptors(dstHeap, dstOffset, srcHeap, srcOffset, count);
+    }
+
     // void DebugLayer::ReleaseDescriptorHeap(DescriptorHeap* heap) noexcept {
     //     m_Wrapped->ReleaseDescriptorHeap(heap);
     //     delete static_cast<DescriptorHeapMeta*>(m_ResourcesMeta[heap].meta);
@@ -223,10 +301,54 @@ namespace RHINO::DebugLayer {
     }
 
     ASPrebuildInfo DebugLayer::GetBLASPrebuildInfo(const BLASDesc& desc) noexcept {
+        if (desc.geometriesCount && !desc.geometries) {
+            DB("BLAS geometries are null while count is "s + std::to_string(desc.geometriesCount));
+            return {};
+        }
         auto result = m_Wrapped->GetBLASPrebuildInfo(desc);
         return result;
     }
 
+    ASPrebuildInfo DebugLayer::GetBLASesPrebuildInfo(size_t count, const BLASDesc* descs) noexcept {
+        if (count && !descs) {
+            DB("BLAS descs are null while count is "s + std::to_string(count));
+            return {};
+        }
+        for (size_t i = 0; i < count; ++i) {
+            if (descs[i].geometriesCount && !descs[i].geometries) {
+                DB("BLAS geometries are null while count is "s + std::to_string(descs[i].geometriesCount) + " in desc " + std::to_string(i));
+                return {};
+            }
+        }
+        auto result = m_Wrapped->GetBLASesPrebuildInfo(count, descs);
+        return result;
+    }
+
+    bool DebugLayer::GetBLASCompactedSize(BLAS* blas, size_t* outSizeInBytes) noexcept {
+        if (!blas || !outSizeInBytes) {
+            DB("BLAS and output size must not be null."s);
+            return false;
+        }
+        return m_Wrapped->GetBLASCompactedSize(blas, outSizeInBytes);
+    }
+
+    bool DebugLayer::GetBLASSerializedSize(BLAS* blas, size_t* outSizeInBytes) noexcept {
+        if (!blas || !outSizeInBytes) {
+            DB("BLAS and output size must not be null."s);
+            return false;
+        }
+        return m_Wrapped->GetBLASSerializedSize(blas, outSizeInBytes);
+    }
+
+    SerializedASInfo DebugLayer::GetSerializedBLASInfo(const void* data, size_t sizeInBytes) noexcept {
+        if (!data) {
+            DB("Serialized BLAS data must not be null."s);
+            return {};
+        }
+        auto result = m_Wrapped->GetSerializedBLASInfo(data, sizeInBytes);
+        return result;
+    }
+
     ASPrebuildInfo DebugLayer::GetTLASPrebuildInfo(const TLASDesc& desc) noexcept {
         auto result = m_Wrapped->GetTLASPrebuildInfo(desc);
         return result;
@@ -253,6 +375,29 @@ namespace RHINO::DebugLayer {
         return result;
     }
 
+    bool DebugLayer::SemaphoresWaitFromHost(size_t count, const SemaphoreWaitDesc* waits, bool waitAll, size_t timeout) noexcept {
+        if (!count) {
+            DB("SemaphoresWaitFromHost called with empty waits list");
+        }
+        for (size_t i = 0; i < count; ++i) {
+            if (!waits[i].semaphore) {
+                DB("SemaphoresWaitFromHost waits["s + std::to_string(i) + "].semaphore is nullptr"s);
+            }
+        }
+        auto result = m_Wrapped->SemaphoresWaitFromHost(count, waits, waitAll, timeout);
+        return result;
+    }
+
+    void DebugLayer::OnSemaphoreValue(const Semaphore* semaphore, uint64_t value, SemaphoreCallback callback, void* userData) noexcept {
+        if (!semaphore) {
+            DB("OnSemaphoreValue semaphore is nullptr"s);
+        }
+        if (!callback) {
+            DB("OnSemaphoreValue callback is nullptr"s);
+        }
+        m_Wrapped->OnSemaphoreValue(semaphore, value, callback, userData);
+    }
+
     void DebugLayer::SemaphoreWaitFromQueue(const Semaphore* semaphore, uint64_t value) noexcept {
         m_Wrapped->SemaphoreWaitFromQueue(semaphore, value);
     }
@@ -277,6 +422,13 @@ namespace RHINO::DebugLayer {
 #endif// WIN32
     }
 
+    void DebugLayer::ValidateSpecializationConstants(size_t count, const char* debugName) const noexcept {
+        if (count && m_BackendAPI != BackendAPI::Vulkan) {
+            DW("Specialization constants are supported by Vulkan only, "s + std::to_string(count) +
+               " constants are ignored for compute PSO '"s + debugName + "'"s);
+        }
+    }
+
 #define RHINO_ENUM_SWITCH_CASE(e) case e: return #e;
     const char* DebugLayer::EtoS(ResourceUsage usage) noexcept {
         switch (usage) {
@@ -294,4 +446,17 @@ namespace RHINO::DebugLayer {
                 return "InvalidResourceUsageEnum";
         }
     }
+
+    const char* DebugLayer::EtoS(DescriptorHeapType type) noexcept {
+        switch (type) {
+            RHINO_ENUM_SWITCH_CASE(DescriptorHeapType::SRV_CBV_UAV)
+            RHINO_ENUM_SWITCH_CASE(DescriptorHeapType::RTV)
+            RHINO_ENUM_SWITCH_CASE(DescriptorHeapType::DSV)
+            RHINO_ENUM_SWITCH_CASE(DescriptorHeapType::Sampler)
+            RHINO_ENUM_SWITCH_CASE(DescriptorHeapType::SRV_CBV_UAV_BuffersOnly)
+            RHINO_ENUM_SWITCH_CASE(DescriptorHeapType::SRV_UAV_TexturesOnly)
+            default:
+                return "InvalidDescriptorHeapTypeEnum";
+        }
+    }
 }// namespace RHINO::DebugLayer
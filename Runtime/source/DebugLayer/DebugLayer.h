@@ -61,32 +61,48 @@ namespace RHINO::DebugLayer {
 
     class DebugLayer final : public RHINOInterface {
     public:
-        explicit DebugLayer(RHINOInterface* wrapped) noexcept;
+        DebugLayer(RHINOInterface* wrapped, BackendAPI backendApi) noexcept;
 
     public:
-        void Initialize() noexcept final;
+        void Initialize(const InitializeDesc& desc) noexcept final;
         void Release() noexcept final;
         RootSignature* SerializeRootSignature(const RHINO::RootSignatureDesc &desc) noexcept final;
         RTPSO* CreateRTPSO(const RTPSODesc& desc) noexcept final;
         RTPSO* CreateSCARRTPSO(const void* scar, uint32_t sizeInBytes, const RTPSODesc& desc) noexcept final;
         ComputePSO* CompileComputePSO(const ComputePSODesc& desc) noexcept final;
+        bool SavePSOCache() noexcept final;
+        ComputePSO* CompileComputePSOAsync(const ComputePSODesc& desc) noexcept final;
+        ComputePSO* CompileSCARComputePSOAsync(const void* scar, uint32_t sizeInBytes, RootSignature* rootSignature,
+                                               const char* debugName, size_t specializationConstantsCount,
+                                               const SpecializationConstant* specializationConstants) noexcept final;
+        void CompileComputePSOs(size_t count, const ComputePSODesc* descs, ComputePSO** outPSOs) noexcept final;
         ComputePSO* CompileSCARComputePSO(const void* scar, uint32_t sizeInBytes, RootSignature* rootSignature,
-                                          const char* debugName) noexcept final;
+                                          const char* debugName, size_t specializationConstantsCount,
+                                          const SpecializationConstant* specializationConstants) noexcept final;
         Buffer* CreateBuffer(size_t size, ResourceHeapType heapType, ResourceUsage usage, size_t structuredStride, const char* name) noexcept final;
         void* MapMemory(Buffer* buffer, size_t offset, size_t size) noexcept final;
         void UnmapMemory(Buffer* buffer) noexcept final;
         Texture2D* CreateTexture2D(const Dim3D& dimensions, size_t mips, TextureFormat format,
                                    ResourceUsage usage, const char* name) noexcept final;
         DescriptorHeap* CreateDescriptorHeap(DescriptorHeapType type, size_t descriptorsCount, const char* name) noexcept final;
+        void CopyDescriptors(DescriptorHeap* dstHeap, size_t dstOffset, DescriptorHeap* srcHeap, size_t srcOffset,
+                             size_t count) noexcept final;
         CommandList* AllocateCommandList(const char* name) noexcept final;
+        FrameContext* CreateFrameContext(const FrameContextDesc& desc) noexcept final;
         Semaphore* CreateSyncSemaphore(uint64_t initialValue) noexcept final;
         ASPrebuildInfo GetBLASPrebuildInfo(const BLASDesc& desc) noexcept final;
+        ASPrebuildInfo GetBLASesPrebuildInfo(size_t count, const BLASDesc* descs) noexcept final;
+        bool GetBLASCompactedSize(BLAS* blas, size_t* outSizeInBytes) noexcept final;
+        bool GetBLASSerializedSize(BLAS* blas, size_t* outSizeInBytes) noexcept final;
+        SerializedASInfo GetSerializedBLASInfo(const void* data, size_t sizeInBytes) noexcept final;
         ASPrebuildInfo GetTLASPrebuildInfo(const TLASDesc& desc) noexcept final;
         void SubmitCommandList(CommandList* cmd) noexcept final;
 
         void SignalFromQueue(Semaphore* semaphore, uint64_t value) noexcept final;
         void SignalFromHost(Semaphore* semaphore, uint64_t value) noexcept final;
         bool SemaphoreWaitFromHost(const Semaphore* semaphore, uint64_t value, size_t timeout) noexcept final;
+        bool SemaphoresWaitFromHost(size_t count, const SemaphoreWaitDesc* waits, bool waitAll, size_t timeout) noexcept final;
+        void OnSemaphoreValue(const Semaphore* semaphore, uint64_t value, SemaphoreCallback callback, void* userData) noexcept final;
         void SemaphoreWaitFromQueue(const Semaphore* semaphore, uint64_t value) noexcept final;
         uint64_t GetSemaphoreCompletedValue(const Semaphore* semaphore) noexcept final;
 
@@ -100,11 +116,16 @@ namespace RHINO::DebugLayer {
          */
         static void DW(const std::string& text) noexcept;
 
+        // Warns about specialization constants ignored by non Vulkan backends.
+        void ValidateSpecializationConstants(size_t count, const char* debugName) const noexcept;
+
         // Enum to String
         static const char* EtoS(ResourceUsage usage) noexcept;
+        static const char* EtoS(DescriptorHeapType type) noexcept;
 
     private:
         RHINOInterface* m_Wrapped = nullptr;
+        BackendAPI m_BackendAPI = BackendAPI::Vulkan;
         std::map<void*, DebugMetadata> m_ResourcesMeta{};
     };
 }// namespace RHINO::DebugLayer
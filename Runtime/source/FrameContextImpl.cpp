@@ -0,0 +1,146 @@
+#include "FrameContextImpl.h"
+
+namespace RHINO {
+    FrameContextImpl::FrameContextImpl(RHINOInterface* rhi, const FrameContextDesc& desc) noexcept : m_RHI(rhi), m_Desc(desc) {
+        m_Desc.framesInFlight = std::max<size_t>(m_Desc.framesInFlight, 1);
+        m_Frames.resize(m_Desc.framesInFlight);
+        m_FrameSemaphore = m_RHI->CreateSyncSemaphore(0);
+
+        if (m_Desc.uploadRingSizeInBytes) {
+            for (Frame& frame : m_Frames) {
+                frame.uploadRing = m_RHI->CreateBuffer(m_Desc.uploadRingSizeInBytes, ResourceHeapType::Upload,
+                                                       ResourceUsage::CopySource | ResourceUsage::ConstantBuffer | ResourceUsage::ShaderResource,
+                                                       0, m_Desc.debugName);
+                frame.uploadRingMapped = static_cast<uint8_t*>(m_RHI->MapMemory(frame.uploadRing, 0, m_Desc.uploadRingSizeInBytes));
+            }
+        }
+
+        // One heap per type, each frame slot owns its own range of it.
+        if (m_Desc.transientCBVSRVUAVDescriptorsCount) {
+            m_TransientCBVSRVUAVHeap = m_RHI->CreateDescriptorHeap(DescriptorHeapType::SRV_CBV_UAV,
+                                                                   m_Desc.transientCBVSRVUAVDescriptorsCount * m_Desc.framesInFlight,
+                                                                   m_Desc.debugName);
+        }
+        if (m_Desc.transientSamplerDescriptorsCount) {
+            m_TransientSamplerHeap = m_RHI->CreateDescriptorHeap(DescriptorHeapType::Sampler,
+                                                                 m_Desc.transientSamplerDescriptorsCount * m_Desc.framesInFlight,
+                                                                 m_Desc.debugName);
+        }
+    }
+
+    void FrameContextImpl::BeginFrame() noexcept {
+        Frame& frame = m_Frames[GetFrameSlot()];
+        WaitForFrame(frame);
+
+        frame.usedCommandListsCount = 0;
+        frame.uploadRingOffset = 0;
+        frame.transientCBVSRVUAVCount = 0;
+        frame.transientSamplerCount = 0;
+    }
+
+    void FrameContextImpl::EndFrame() noexcept {
+        Frame& frame = m_Frames[GetFrameSlot()];
+        for (size_t i = 0; i < frame.usedCommandListsCount; ++i) {
+            m_RHI->SubmitCommandList(frame.commandLists[i]);
+        }
+        frame.completionValue = m_NextCompletionValue++;
+        m_RHI->SignalFromQueue(m_FrameSemaphore, frame.completionValue);
+        ++m_FrameNumber;
+    }
+
+    size_t FrameContextImpl::GetFrameSlot() noexcept {
+        return m_FrameNumber % m_Desc.framesInFlight;
+    }
+
+    CommandList* FrameContextImpl::AllocateCommandList(const char* name) noexcept {
+        Frame& frame = m_Frames[GetFrameSlot()];
+        // Lists of this slot are idle since BeginFrame waited for the frame that used them.
+        if (frame.usedCommandListsCount < frame.commandLists.size()) {
+            CommandList* result = frame.commandLists[frame.usedCommandListsCount++];
+            result->Reset();
+            return result;
+        }
+        CommandList* result = m_RHI->AllocateCommandList(name);
+        frame.commandLists.push_back(result);
+        ++frame.usedCommandListsCount;
+        return result;
+    }
+
+    bool FrameContextImpl::AllocateUpload(size_t sizeInBytes, size_t alignment, FrameUploadAllocation* outAllocation) noexcept {
+        Frame& frame = m_Frames[GetFrameSlot()];
+        alignment = std::max<size_t>(alignment, 1);
+        const size_t offset = RHINO_CEIL_TO_MULTIPLE_OF(frame.uploadRingOffset, alignment);
+        if (!frame.uploadRing || offset + sizeInBytes > m_Desc.uploadRingSizeInBytes) {
+            return false;
+        }
+        frame.uploadRingOffset = offset + sizeInBytes;
+
+        outAllocation->buffer = frame.uploadRing;
+        outAllocation->offset = offset;
+        outAllocation->mappedData = frame.uploadRingMapped + offset;
+        return true;
+    }
+
+    size_t FrameContextImpl::AllocateTransientDescriptors(DescriptorHeapType heapType, size_t count) noexcept {
+        Frame& frame = m_Frames[GetFrameSlot()];
+        size_t* allocated = nullptr;
+        size_t perFrameCount = 0;
+        switch (heapType) {
+            case DescriptorHeapType::SRV_CBV_UAV:
+                allocated = &frame.transientCBVSRVUAVCount;
+                perFrameCount = m_Desc.transientCBVSRVUAVDescriptorsCount;
+                break;
+            case DescriptorHeapType::Sampler:
+                allocated = &frame.transientSamplerCount;
+                perFrameCount = m_Desc.transientSamplerDescriptorsCount;
+                break;
+            default:
+                assert(0 && "Transient descriptors are supported for SRV_CBV_UAV and Sampler heaps only.");
+                return ~0ull;
+        }
+        if (*allocated + count > perFrameCount) {
+            return ~0ull;
+        }
+        const size_t result = GetFrameSlot() * perFrameCount + *allocated;
+        *allocated += count;
+        return result;
+    }
+
+    DescriptorHeap* FrameContextImpl::GetTransientHeap(DescriptorHeapType heapType) noexcept {
+        switch (heapType) {
+            case DescriptorHeapType::SRV_CBV_UAV:
+                return m_TransientCBVSRVUAVHeap;
+            case DescriptorHeapType::Sampler:
+                return m_TransientSamplerHeap;
+            default:
+                return nullptr;
+        }
+    }
+
+    void FrameContextImpl::Release() noexcept {
+        for (Frame& frame : m_Frames) {
+            WaitForFrame(frame);
+            for (CommandList* cmd : frame.commandLists) {
+                cmd->Release();
+            }
+            if (frame.uploadRing) {
+                m_RHI->UnmapMemory(frame.uploadRing);
+                frame.uploadRing->Release();
+            }
+        }
+        if (m_TransientCBVSRVUAVHeap) {
+            m_TransientCBVSRVUAVHeap->Release();
+        }
+        if (m_TransientSamplerHeap) {
+            m_TransientSamplerHeap->Release();
+        }
+        m_FrameSemaphore->Release();
+        delete this;
+    }
+
+    void FrameContextImpl::WaitForFrame(Frame& frame) noexcept {
+        if (frame.completionValue) {
+            m_RHI->SemaphoreWaitFromHost(m_FrameSemaphore, frame.completionValue, ~0ull);
+        }
+    }
+} // namespace RHINO
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <RHINO.h>
+
+namespace RHINO {
+    /**
+     * Backend agnostic FrameContext built on top of RHINOInterface public API.
+     */
+    class FrameContextImpl : public FrameContext {
+    private:
+        struct Frame {
+            // Frame semaphore value signaled after frame submission. Zero if slot was not submitted yet.
+            uint64_t completionValue = 0;
+            // Command lists are kept across frames of the slot, first usedCommandListsCount are allocated in current frame.
+            std::vector<CommandList*> commandLists{};
+            size_t usedCommandListsCount = 0;
+            Buffer* uploadRing = nullptr;
+            uint8_t* uploadRingMapped = nullptr;
+            size_t uploadRingOffset = 0;
+            size_t transientCBVSRVUAVCount = 0;
+            size_t transientSamplerCount = 0;
+        };
+
+    public:
+        explicit FrameContextImpl(RHINOInterface* rhi, const FrameContextDesc& desc) noexcept;
+
+    public:
+        void BeginFrame() noexcept final;
+        void EndFrame() noexcept final;
+        size_t GetFrameSlot() noexcept final;
+
+        CommandList* AllocateCommandList(const char* name) noexcept final;
+        bool AllocateUpload(size_t sizeInBytes, size_t alignment, FrameUploadAllocation* outAllocation) noexcept final;
+        size_t AllocateTransientDescriptors(DescriptorHeapType heapType, size_t count) noexcept final;
+        DescriptorHeap* GetTransientHeap(DescriptorHeapType heapType) noexcept final;
+
+    public:
+        void Release() noexcept final;
+
+    private:
+        void WaitForFrame(Frame& frame) noexcept;
+
+    private:
+        RHINOInterface* m_RHI = nullptr;
+        FrameContextDesc m_Desc = {};
+        std::vector<Frame> m_Frames{};
+        size_t m_FrameNumber = 0;
+
+        Semaphore* m_FrameSemaphore = nullptr;
+        uint64_t m_NextCompletionValue = 1;
+
+        DescriptorHeap* m_TransientCBVSRVUAVHeap = nullptr;
+        DescriptorHeap* m_TransientSamplerHeap = nullptr;
+    };
+} // namespace RHINO
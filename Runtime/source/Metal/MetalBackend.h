@@ -14,13 +14,15 @@ namespace RHINO::APIMetal {
         MetalBackend() noexcept {}
 
     public:
-        void Initialize() noexcept final;
+        void Initialize(const InitializeDesc& desc) noexcept final;
         void Release() noexcept final;
 
     public:
         RootSignature* SerializeRootSignature(const RHINO::RootSignatureDesc &desc) noexcept final;
         RTPSO* CreateRTPSO(const RTPSODesc& desc) noexcept final;
         ComputePSO* CompileComputePSO(const ComputePSODesc& desc) noexcept final;
+        ComputePSO* CompileComputePSOAsync(const ComputePSODesc& desc) noexcept final;
+        bool SavePSOCache() noexcept final;
 
     public:
         Buffer* CreateBuffer(size_t size, ResourceHeapType heapType, ResourceUsage usage, size_t structuredStride, const char* name) noexcept final;
@@ -31,6 +33,8 @@ namespace RHINO::APIMetal {
                                    const char* name) noexcept final;
         Sampler* CreateSampler(const RHINO::SamplerDesc &desc) noexcept final;
         DescriptorHeap* CreateDescriptorHeap(DescriptorHeapType type, size_t descriptorsCount, const char* name) noexcept final;
+        void CopyDescriptors(DescriptorHeap* dstHeap, size_t dstOffset, DescriptorHeap* srcHeap, size_t srcOffset,
+                             size_t count) noexcept final;
         Swapchain* CreateSwapchain(const RHINO::SwapchainDesc &desc) noexcept final;
         CommandList* AllocateCommandList(const char* name) noexcept final;
 
@@ -39,6 +43,10 @@ namespace RHINO::APIMetal {
         void SubmitCommandList(CommandList* cmd) noexcept final;
         void SwapchainPresent(Swapchain *swapchain, Texture2D *toPresent, size_t width, size_t height) noexcept final;
         ASPrebuildInfo GetBLASPrebuildInfo(const BLASDesc& desc) noexcept final;
+        ASPrebuildInfo GetBLASesPrebuildInfo(size_t count, const BLASDesc* descs) noexcept final;
+        bool GetBLASCompactedSize(BLAS* blas, size_t* outSizeInBytes) noexcept final;
+        bool GetBLASSerializedSize(BLAS* blas, size_t* outSizeInBytes) noexcept final;
+        SerializedASInfo GetSerializedBLASInfo(const void* data, size_t sizeInBytes) noexcept final;
         ASPrebuildInfo GetTLASPrebuildInfo(const TLASDesc& desc) noexcept final;
 
     public:
@@ -46,6 +54,8 @@ namespace RHINO::APIMetal {
         void SignalFromQueue(Semaphore* semaphore, uint64_t value) noexcept final;
         void SignalFromHost(Semaphore* semaphore, uint64_t value) noexcept final;
         bool SemaphoreWaitFromHost(const Semaphore* semaphore, uint64_t value, size_t timeout) noexcept final;
+        bool SemaphoresWaitFromHost(size_t count, const SemaphoreWaitDesc* waits, bool waitAll, size_t timeout) noexcept final;
+        void OnSemaphoreValue(const Semaphore* semaphore, uint64_t value, SemaphoreCallback callback, void* userData) noexcept final;
         void SemaphoreWaitFromQueue(const Semaphore* semaphore, uint64_t value) noexcept final;
         uint64_t GetSemaphoreCompletedValue(const Semaphore* semaphore) noexcept final;
 
@@ -56,6 +66,9 @@ namespace RHINO::APIMetal {
         id<MTLCommandQueue> m_CopyQueue;
 
         IRCompiler* m_IRCompiler = nullptr;
+        size_t m_HostWaitSpinTimeInMicroseconds = 0;
+        // Notifies semaphore callbacks on a serial queue.
+        MTLSharedEventListener* m_SemaphoreListener = nil;
     };
 
     RHINOInterface* AllocateMetalBackend() noexcept {
@@ -11,14 +11,18 @@
 #import <metal_irconverter_runtime/metal_irconverter_runtime.h>
 
 namespace RHINO::APIMetal {
-    void MetalBackend::Initialize() noexcept {
+    void MetalBackend::Initialize(const InitializeDesc& desc) noexcept {
         m_IRCompiler = IRCompilerCreate();
+        m_HostWaitSpinTimeInMicroseconds = desc.hostWaitSpinTimeInMicroseconds;
 
         m_Device = MTLCopyAllDevices()[0];
         m_DefaultQueue = [m_Device newCommandQueue];
         m_AsyncComputeQueue = [m_Device newCommandQueue];
         m_CopyQueue = [m_Device newCommandQueue];
 
+        dispatch_queue_t callbacksQueue = dispatch_queue_create("RHINO.SemaphoreCallbacks", DISPATCH_QUEUE_SERIAL);
+        m_SemaphoreListener = [[MTLSharedEventListener alloc] initWithDispatchQueue:callbacksQueue];
+
         {
             NSError* error = nil;
             auto manager = [MTLCaptureManager sharedCaptureManager];
@@ -122,6 +126,7 @@ namespace RHINO::APIMetal {
     RTPSO* APIMetal::MetalBackend::CreateRTPSO(const RHINO::RTPSODesc& desc) noexcept { return nullptr; }
 
     ComputePSO* MetalBackend::CompileComputePSO(const ComputePSODesc& desc) noexcept {
+        // DXIL has no specialization constants, desc.specializationConstants are ignored.
         auto* metalRootSignature = INTERPRET_AS<MetalRootSignature*>(desc.rootSignature);
 
         IRError* pError = nullptr;
@@ -154,6 +159,7 @@ namespace RHINO::APIMetal {
         result->localWorkgroupSize[0] = csInfo.info_1_0.tg_size[0];
         result->localWorkgroupSize[1] = csInfo.info_1_0.tg_size[1];
         result->localWorkgroupSize[2] = csInfo.info_1_0.tg_size[2];
+        result->SetWorkgroupSize({csInfo.info_1_0.tg_size[0], csInfo.info_1_0.tg_size[1], csInfo.info_1_0.tg_size[2]});
 
         IRShaderReflectionDestroy(reflection);
         IRObjectDestroy(pDXIL);
@@ -182,6 +188,16 @@ namespace RHINO::APIMetal {
         return result;
     }
 
+    ComputePSO* MetalBackend::CompileComputePSOAsync(const ComputePSODesc& desc) noexcept {
+        // Compiled synchronously, returned PSO is ready right away.
+        return CompileComputePSO(desc);
+    }
+
+    bool MetalBackend::SavePSOCache() noexcept {
+        // PSO cache persistence is Vulkan only.
+        return false;
+    }
+
     Buffer* MetalBackend::CreateBuffer(size_t size, ResourceHeapType heapType, ResourceUsage usage,
                                             size_t structuredStride, const char* name) noexcept {
         auto* result = new MetalBuffer{};
@@ -250,6 +266,18 @@ namespace RHINO::APIMetal {
         return result;
     }
 
+    void MetalBackend::CopyDescriptors(DescriptorHeap* dstHeap, size_t dstOffset, DescriptorHeap* srcHeap, size_t srcOffset,
+                                       size_t count) noexcept {
+        auto* metalDstHeap = INTERPRET_AS<MetalDescriptorHeap*>(dstHeap);
+        auto* metalSrcHeap = INTERPRET_AS<MetalDescriptorHeap*>(srcHeap);
+        assert(dstOffset + count <= metalDstHeap->m_Resources.size() && srcOffset + count <= metalSrcHeap->m_Resources.size());
+
+        auto* dstEntries = static_cast<IRDescriptorTableEntry*>([metalDstHeap->m_DescriptorHeap contents]);
+        auto* srcEntries = static_cast<IRDescriptorTableEntry*>([metalSrcHeap->m_DescriptorHeap contents]);
+        memmove(dstEntries + dstOffset, srcEntries + srcOffset, sizeof(IRDescriptorTableEntry) * count);
+        std::copy_n(metalSrcHeap->m_Resources.begin() + srcOffset, count, metalDstHeap->m_Resources.begin() + dstOffset);
+    }
+
     Swapchain* MetalBackend::CreateSwapchain(const SwapchainDesc& desc) noexcept {
         auto* result = new MetalSwapchain{};
         result->Initialize(m_Device, m_DefaultQueue, desc);
@@ -283,36 +311,77 @@ namespace RHINO::APIMetal {
     }
 
     ASPrebuildInfo MetalBackend::GetBLASPrebuildInfo(const BLASDesc& desc) noexcept {
-        auto triangleGeoDesc = [MTLAccelerationStructureTriangleGeometryDescriptor descriptor];
-        triangleGeoDesc.vertexBuffer = nil;
-        triangleGeoDesc.vertexBufferOffset = 0;
-        triangleGeoDesc.vertexFormat = Convert::ToMTLMTLAttributeFormat(desc.vertexFormat);
-        triangleGeoDesc.vertexStride = desc.vertexStride;
-        triangleGeoDesc.indexBuffer = nil;
-        triangleGeoDesc.indexBufferOffset = 0;
-        triangleGeoDesc.indexType = Convert::ToMTLIndexType(desc.indexFormat);
-        triangleGeoDesc.triangleCount = desc.indexCount / 3;
-        triangleGeoDesc.primitiveDataBuffer = nil;
-        triangleGeoDesc.primitiveDataStride = 0;
-        triangleGeoDesc.primitiveDataElementSize = 0;
-        triangleGeoDesc.transformationMatrixBuffer = nil;
-        triangleGeoDesc.transformationMatrixBufferOffset = 0;
+        auto geometryDescriptors = [NSMutableArray arrayWithCapacity:desc.geometriesCount];
+        for (size_t i = 0; i < desc.geometriesCount; ++i) {
+            const BLASGeometryDesc& geometry = desc.geometries[i];
+
+            auto triangleGeoDesc = [MTLAccelerationStructureTriangleGeometryDescriptor descriptor];
+            triangleGeoDesc.vertexBuffer = nil;
+            triangleGeoDesc.vertexBufferOffset = 0;
+            triangleGeoDesc.vertexFormat = Convert::ToMTLMTLAttributeFormat(geometry.vertexFormat);
+            triangleGeoDesc.vertexStride = geometry.vertexStride;
+            triangleGeoDesc.indexBuffer = nil;
+            triangleGeoDesc.indexBufferOffset = 0;
+            triangleGeoDesc.indexType = Convert::ToMTLIndexType(geometry.indexFormat);
+            triangleGeoDesc.triangleCount = (geometry.indexBuffer ? geometry.indexCount : geometry.vertexCount) / 3;
+            triangleGeoDesc.opaque = geometry.opaque;
+            triangleGeoDesc.primitiveDataBuffer = nil;
+            triangleGeoDesc.primitiveDataStride = 0;
+            triangleGeoDesc.primitiveDataElementSize = 0;
+            triangleGeoDesc.transformationMatrixBuffer = nil;
+            triangleGeoDesc.transformationMatrixBufferOffset = 0;
+            [geometryDescriptors addObject:triangleGeoDesc];
+        }
 
         auto accelerationStructureDescriptor = [MTLPrimitiveAccelerationStructureDescriptor descriptor];
-        auto geometryDescriptors = [NSMutableArray array];
-        [geometryDescriptors addObject:triangleGeoDesc];
 
         accelerationStructureDescriptor.geometryDescriptors = geometryDescriptors;
         MTLAccelerationStructureSizes sizes = [m_Device accelerationStructureSizesWithDescriptor:accelerationStructureDescriptor];
 
         ASPrebuildInfo result{};
         result.MaxASSizeInBytes = sizes.accelerationStructureSize;
-        result.MaxASSizeInBytes = sizes.buildScratchBufferSize;
+        result.scratchBufferSizeInBytes = sizes.buildScratchBufferSize;
         return result;
     }
 
+    ASPrebuildInfo MetalBackend::GetBLASesPrebuildInfo(size_t count, const BLASDesc* descs) noexcept {
+        // Matches MetalCommandList::BuildBLASes layout with 256 bytes aligned scratch regions.
+        ASPrebuildInfo result{};
+        for (size_t i = 0; i < count; ++i) {
+            const ASPrebuildInfo info = GetBLASPrebuildInfo(descs[i]);
+            result.scratchBufferSizeInBytes += RHINO_CEIL_TO_POWER_OF_TWO(info.scratchBufferSizeInBytes, 256);
+            result.MaxASSizeInBytes += info.MaxASSizeInBytes;
+        }
+        return result;
+    }
+
+    bool MetalBackend::GetBLASCompactedSize(BLAS* blas, size_t* outSizeInBytes) noexcept {
+        auto* metalBLAS = INTERPRET_AS<MetalBLAS*>(blas);
+        return metalBLAS->GetCompactedSize(outSizeInBytes);
+    }
+
+    bool MetalBackend::GetBLASSerializedSize(BLAS* blas, size_t* outSizeInBytes) noexcept {
+        // Metal has no acceleration structure serialization.
+        *outSizeInBytes = 0;
+        return true;
+    }
+
+    SerializedASInfo MetalBackend::GetSerializedBLASInfo(const void* data, size_t sizeInBytes) noexcept {
+        return {};
+    }
+
     ASPrebuildInfo MetalBackend::GetTLASPrebuildInfo(const TLASDesc& desc) noexcept {
+        auto accelerationStructureDescriptor = [MTLInstanceAccelerationStructureDescriptor descriptor];
+        accelerationStructureDescriptor.instanceCount = desc.blasInstancesCount;
+        accelerationStructureDescriptor.instanceDescriptorType = MTLAccelerationStructureInstanceDescriptorTypeDefault;
+        accelerationStructureDescriptor.usage = desc.allowUpdate ? MTLAccelerationStructureUsageRefit : MTLAccelerationStructureUsageNone;
+        MTLAccelerationStructureSizes sizes = [m_Device accelerationStructureSizesWithDescriptor:accelerationStructureDescriptor];
 
+        ASPrebuildInfo result{};
+        result.MaxASSizeInBytes = sizes.accelerationStructureSize;
+        result.scratchBufferSizeInBytes = sizes.buildScratchBufferSize;
+        result.updateScratchBufferSizeInBytes = desc.allowUpdate ? sizes.refitScratchBufferSize : 0;
+        return result;
     }
 
     Semaphore* MetalBackend::CreateSyncSemaphore(uint64_t initialValue) noexcept {
@@ -336,9 +405,62 @@ namespace RHINO::APIMetal {
 
     bool MetalBackend::SemaphoreWaitFromHost(const Semaphore* semaphore, uint64_t value, size_t timeout) noexcept {
         const auto* metalSemaphore = INTERPRET_AS<const MetalSemaphore*>(semaphore);
+        const bool reached = SpinWait<std::milli>(m_HostWaitSpinTimeInMicroseconds, timeout, SIZE_MAX, [&]() {
+            return metalSemaphore->event.signaledValue >= value;
+        });
+        if (reached) {
+            return true;
+        }
         return WaitForMTLSharedEventValue(metalSemaphore->event, value, timeout);
     }
 
+    bool MetalBackend::SemaphoresWaitFromHost(size_t count, const SemaphoreWaitDesc* waits, bool waitAll, size_t timeout) noexcept {
+        if (waitAll) {
+            for (size_t i = 0; i < count; ++i) {
+                if (!SemaphoreWaitFromHost(waits[i].semaphore, waits[i].value, timeout)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        const auto isAnyReached = [&]() {
+            for (size_t i = 0; i < count; ++i) {
+                const auto* metalSemaphore = INTERPRET_AS<const MetalSemaphore*>(waits[i].semaphore);
+                if (metalSemaphore->event.signaledValue >= waits[i].value) {
+                    return true;
+                }
+            }
+            return false;
+        };
+        if (SpinWait<std::milli>(m_HostWaitSpinTimeInMicroseconds, timeout, SIZE_MAX, isAnyReached)) {
+            return true;
+        }
+
+        //TODO: MTLSharedEvent has no multiple events wait, polling signaled values instead.
+        constexpr size_t SLEEP_SESSION_TIME_MS = 1;
+        size_t totalWaited = 0;
+        while (true) {
+            if (isAnyReached()) {
+                return true;
+            }
+            if (totalWaited >= timeout) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_SESSION_TIME_MS));
+            totalWaited += SLEEP_SESSION_TIME_MS;
+        }
+    }
+
+    void MetalBackend::OnSemaphoreValue(const Semaphore* semaphore, uint64_t value, SemaphoreCallback callback, void* userData) noexcept {
+        const auto* metalSemaphore = INTERPRET_AS<const MetalSemaphore*>(semaphore);
+        [metalSemaphore->event notifyListener:m_SemaphoreListener
+                                      atValue:value
+                                        block:^(id<MTLSharedEvent> event, uint64_t signaledValue) {
+                                            callback(userData);
+                                        }];
+    }
+
     void MetalBackend::SemaphoreWaitFromQueue(const Semaphore* semaphore, uint64_t value) noexcept {
         const auto* metalSemaphore = INTERPRET_AS<const MetalSemaphore*>(semaphore);
         id<MTLCommandBuffer> cmd = [m_DefaultQueue commandBuffer];
@@ -71,7 +71,7 @@ namespace RHINO::APIMetal {
         }
     };
 
-    class MetalComputePSO : public ComputePSO {
+    class MetalComputePSO : public ComputePSOBase {
     public:
         id<MTLComputePipelineState> pso = nil;
         uint32_t localWorkgroupSize[3] = {};
@@ -85,16 +85,52 @@ namespace RHINO::APIMetal {
     class MetalBLAS : public BLASBase {
     public:
         id<MTLAccelerationStructure> accelerationStructure = nil;
+        // Shared buffer with compacted sizes of BLASes queried together and command buffer writing it.
+        id<MTLBuffer> compactedSizeBuffer = nil;
+        size_t compactedSizeIndex = 0;
+        id<MTLCommandBuffer> compactedSizeCmd = nil;
+
+    public:
+        // Returns false while compacted size is not requested or not yet written by GPU.
+        bool GetCompactedSize(size_t* outSize) const noexcept {
+            if (!this->compactedSizeBuffer || this->compactedSizeCmd.status != MTLCommandBufferStatusCompleted) {
+                return false;
+            }
+            *outSize = static_cast<const uint32_t*>(this->compactedSizeBuffer.contents)[this->compactedSizeIndex];
+            return true;
+        }
 
-    public:
         void Release() noexcept final {
             delete this;
         }
     };
 
+    /**
+     * Shared storage TLAS instance buffer read by builds directly.
+     */
+    struct MetalTLASInstanceBuffer {
+        id<MTLBuffer> buffer = nil;
+        // Host copy of written instances, so writes skip unchanged ones.
+        std::vector<MTLAccelerationStructureInstanceDescriptor> instances{};
+        // Command buffer that encoded the last build reading the buffer.
+        id<MTLCommandBuffer> lastUse = nil;
+
+        bool IsIdle() const noexcept {
+            return !this->lastUse || this->lastUse.status == MTLCommandBufferStatusCompleted ||
+                   this->lastUse.status == MTLCommandBufferStatusError;
+        }
+    };
+
     class MetalTLAS : public TLASBase {
     public:
         id<MTLAccelerationStructure> accelerationStructure = nil;
+        // Refit reuses build descriptor, it references the instanced BLASes. Instance buffer is set per build.
+        MTLInstanceAccelerationStructureDescriptor* descriptor = nil;
+        size_t instancesCount = 0;
+        // Builds and updates write instances to an idle buffer of the ring, ring grows while all of them are in use.
+        std::vector<MetalTLASInstanceBuffer> instanceBuffers{};
+        // Index of each instanced BLAS in descriptor instancedAccelerationStructures.
+        std::unordered_map<id<MTLAccelerationStructure>, uint32_t> blasIndices{};
 
     public:
         void Release() noexcept final {
@@ -21,6 +21,7 @@ namespace RHINO::APIMetal {
     private:
         id<MTLCommandBuffer> m_Cmd = nil;
         id<MTLDevice> m_Device = nil;
+        id<MTLCommandQueue> m_Queue = nil;
 
         MetalRootSignature* m_CurRootSignature = nullptr;
         MetalComputePSO* m_CurComputePSO = nullptr;
@@ -28,6 +29,8 @@ namespace RHINO::APIMetal {
         size_t m_CBVSRVUAVHeapOffset = 0;
         MetalDescriptorHeap* m_SamplerHeap = nullptr;
         size_t m_SamplerHeapOffset = 0;
+        // Compacted BLASes sources, owned by the caller until this command list is submitted, retired on submission.
+        std::vector<MetalBLAS*> m_CompactedSources{};
 
         // Top Level Argument Buffers ring emulating D3D12 Root Signatures.
         id<MTLBuffer> m_RootSignaturesRing = nil;
@@ -40,9 +43,12 @@ namespace RHINO::APIMetal {
         void SubmitToQueue() noexcept;
 
     public:
+        void Reset() noexcept final;
         void Dispatch(const DispatchDesc& desc) noexcept final;
+        void DispatchThreads(size_t threadsX, size_t threadsY, size_t threadsZ) noexcept final;
         void Draw() noexcept final;
         void SetComputePSO(ComputePSO* pso) noexcept final;
+        bool TrySetComputePSO(ComputePSO* pso) noexcept final;
         void SetHeap(DescriptorHeap* CBVSRVUAVHeap, DescriptorHeap* samplerHeap) noexcept final;
         void CopyBuffer(Buffer* src, Buffer* dst, size_t srcOffset, size_t dstOffset, size_t size) noexcept final;
         void DispatchRays(const DispatchRaysDesc& desc) noexcept final;
@@ -54,8 +60,25 @@ namespace RHINO::APIMetal {
 
     public:
         BLAS* BuildBLAS(const BLASDesc& desc, Buffer* scratchBuffer, size_t scratchBufferStartOffset, const char* name) noexcept final;
+        void BuildBLASes(size_t count, const BLASDesc* descs, Buffer* scratchBuffer, size_t scratchBufferStartOffset, const char* name,
+                         BLAS** outBLASes) noexcept final;
+        void QueryBLASCompactedSizes(size_t count, BLAS* const* blases) noexcept final;
+        void CompactBLASes(size_t count, BLAS* const* blases, const char* name, BLAS** outCompacted) noexcept final;
+        void QueryBLASSerializedSizes(size_t count, BLAS* const* blases) noexcept final;
+        void SerializeBLAS(BLAS* blas, Buffer* dstBuffer, size_t dstBufferStartOffset) noexcept final;
+        BLAS* DeserializeBLAS(const SerializedASInfo& info, Buffer* srcBuffer, size_t srcBufferStartOffset, const char* name) noexcept final;
         TLAS* BuildTLAS(const TLASDesc& desc, Buffer* scratchBuffer, size_t scratchBufferStartOffset, const char* name) noexcept final;
+        void UpdateTLAS(TLAS* tlas, const TLASDesc& desc, Buffer* scratchBuffer, size_t scratchBufferStartOffset) noexcept final;
         void BuildRTPSO(RTPSO* pso) noexcept final;
+
+    private:
+        // Returns scratch size used by the build, aligned for the next build start.
+        MetalBLAS* EncodeBLASBuild(id<MTLAccelerationStructureCommandEncoder> encoder, const BLASDesc& desc, id<MTLBuffer> scratchBuffer,
+                                   size_t scratchBufferOffset, const char* name, size_t* outScratchSizeInBytes) noexcept;
+        // Returns instance buffer of TLAS no encoded or executing build reads, marked as used by this command list.
+        MetalTLASInstanceBuffer* AcquireTLASInstanceBuffer(MetalTLAS* tlas) noexcept;
+        // Writes only instances that differ from the ones written to this buffer before.
+        void WriteTLASInstances(MetalTLAS* tlas, MetalTLASInstanceBuffer* instanceBuffer, const TLASDesc& desc) noexcept;
     };
 } // namespace RHINO::APIMetal
 
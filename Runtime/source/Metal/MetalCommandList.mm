@@ -12,6 +12,7 @@ namespace RHINO::APIMetal {
 
     void MetalCommandList::Initialize(id<MTLDevice> device, id<MTLCommandQueue> queue) noexcept {
         m_Device = device;
+        m_Queue = queue;
         m_RootSignaturesRing = [m_Device newBufferWithLength:sizeof(RootSignatureT) * ROOT_SIGNATURE_RING_SIZE
                                                      options:MTLResourceStorageModeManaged];
         [m_RootSignaturesRing setLabel: @"RootSignatureRing"];
@@ -23,8 +24,26 @@ namespace RHINO::APIMetal {
         m_Cmd = [queue commandBuffer];
     }
 
+    void MetalCommandList::Reset() noexcept {
+        // Metal command buffers are one shot, a new one is taken from the queue.
+        m_Cmd = [m_Queue commandBuffer];
+        m_CurRootSignature = nullptr;
+        m_CurComputePSO = nullptr;
+        m_CBVSRVUAVHeap = nullptr;
+        m_CBVSRVUAVHeapOffset = 0;
+        m_SamplerHeap = nullptr;
+        m_SamplerHeapOffset = 0;
+        // Ownership of compaction sources is passed on submission only.
+        m_CompactedSources.clear();
+    }
+
     void MetalCommandList::SubmitToQueue() noexcept {
         [m_Cmd commit];
+        // Command buffer retains the source structures until it completes, so they are released right away.
+        for (MetalBLAS* source : m_CompactedSources) {
+            source->Release();
+        }
+        m_CompactedSources.clear();
     }
 
     void MetalCommandList::Release() noexcept {
@@ -100,11 +119,35 @@ namespace RHINO::APIMetal {
 
     void MetalCommandList::Draw() noexcept {}
 
+    void MetalCommandList::DispatchThreads(size_t threadsX, size_t threadsY, size_t threadsZ) noexcept {
+        assert(m_CurComputePSO);
+        const Dim3D workgroupSize = m_CurComputePSO->GetWorkgroupSize();
+        assert(workgroupSize.width && workgroupSize.height && workgroupSize.depth && "Workgroup size of compute PSO is unknown.");
+
+        DispatchDesc desc{};
+        desc.dimensionsX = (threadsX + workgroupSize.width - 1) / workgroupSize.width;
+        desc.dimensionsY = (threadsY + workgroupSize.height - 1) / workgroupSize.height;
+        desc.dimensionsZ = (threadsZ + workgroupSize.depth - 1) / workgroupSize.depth;
+        Dispatch(desc);
+    }
+
     void MetalCommandList::SetComputePSO(ComputePSO* pso) noexcept {
         auto* metalPSO = INTERPRET_AS<MetalComputePSO*>(pso);
+        metalPSO->Wait();
+        if (metalPSO->IsFailed()) {
+            return;
+        }
         m_CurComputePSO = metalPSO;
     }
 
+    bool MetalCommandList::TrySetComputePSO(ComputePSO* pso) noexcept {
+        if (!pso->IsReady() || pso->IsFailed()) {
+            return false;
+        }
+        SetComputePSO(pso);
+        return true;
+    }
+
     void MetalCommandList::SetHeap(DescriptorHeap* CBVSRVUAVHeap, DescriptorHeap* samplerHeap) noexcept {
         m_CBVSRVUAVHeap = INTERPRET_AS<MetalDescriptorHeap*>(CBVSRVUAVHeap);
         m_CBVSRVUAVHeapOffset = 0;
@@ -151,32 +194,61 @@ namespace RHINO::APIMetal {
     }
     BLAS* MetalCommandList::BuildBLAS(const BLASDesc& desc, Buffer* scratchBuffer, size_t scratchBufferStartOffset,
                                       const char* name) noexcept {
-        auto* result = new MetalBLAS{};
         auto* metalScratch = INTERPRET_AS<MetalBuffer*>(scratchBuffer);
+        size_t scratchSize = 0;
+
+        id<MTLAccelerationStructureCommandEncoder> encoder = [m_Cmd accelerationStructureCommandEncoder];
+        MetalBLAS* result = EncodeBLASBuild(encoder, desc, metalScratch->buffer, scratchBufferStartOffset, name, &scratchSize);
+        [encoder endEncoding];
+        return result;
+    }
+
+    void MetalCommandList::BuildBLASes(size_t count, const BLASDesc* descs, Buffer* scratchBuffer, size_t scratchBufferStartOffset,
+                                       const char* name, BLAS** outBLASes) noexcept {
+        auto* metalScratch = INTERPRET_AS<MetalBuffer*>(scratchBuffer);
+        size_t scratchOffset = scratchBufferStartOffset;
+
+        // All builds share one encoder, scratch regions don't overlap.
+        id<MTLAccelerationStructureCommandEncoder> encoder = [m_Cmd accelerationStructureCommandEncoder];
+        for (size_t i = 0; i < count; ++i) {
+            size_t scratchSize = 0;
+            outBLASes[i] = EncodeBLASBuild(encoder, descs[i], metalScratch->buffer, scratchOffset, name, &scratchSize);
+            scratchOffset += scratchSize;
+        }
+        [encoder endEncoding];
+    }
+
+    MetalBLAS* MetalCommandList::EncodeBLASBuild(id<MTLAccelerationStructureCommandEncoder> encoder, const BLASDesc& desc,
+                                                 id<MTLBuffer> scratchBuffer, size_t scratchBufferOffset, const char* name,
+                                                 size_t* outScratchSizeInBytes) noexcept {
+        auto* result = new MetalBLAS{};
 
-        auto* metalVertex = INTERPRET_AS<MetalBuffer*>(desc.vertexBuffer);
-        auto* metalIndex = INTERPRET_AS<MetalBuffer*>(desc.indexBuffer);
-        auto* metalTransform = INTERPRET_AS<MetalBuffer*>(desc.transformBuffer);
-
-        auto triangleGeoDesc = [MTLAccelerationStructureTriangleGeometryDescriptor descriptor];
-        triangleGeoDesc.vertexBuffer = metalVertex->buffer;
-        triangleGeoDesc.vertexBufferOffset = desc.vertexBufferStartOffset;
-        triangleGeoDesc.vertexFormat = Convert::ToMTLMTLAttributeFormat(desc.vertexFormat);
-        triangleGeoDesc.vertexStride = desc.vertexStride;
-        triangleGeoDesc.indexBuffer = metalIndex->buffer;
-        triangleGeoDesc.indexBufferOffset = desc.indexBufferStartOffset;
-        triangleGeoDesc.indexType = MTLIndexTypeUInt32;
-        triangleGeoDesc.triangleCount = desc.indexCount / 3;
-        triangleGeoDesc.primitiveDataBuffer = nil;
-        triangleGeoDesc.primitiveDataStride = 0;
-        triangleGeoDesc.primitiveDataElementSize = 0;
-        triangleGeoDesc.transformationMatrixBuffer = metalTransform->buffer;
-        triangleGeoDesc.transformationMatrixBufferOffset = desc.transformBufferStartOffset;
-        triangleGeoDesc.intersectionFunctionTableOffset = 0; // TODO <- take from desc
-        triangleGeoDesc.label = [NSString stringWithUTF8String:name];
-
-        auto geometryDescriptors = [NSMutableArray array];
-        [geometryDescriptors addObject:triangleGeoDesc];
+        auto geometryDescriptors = [NSMutableArray arrayWithCapacity:desc.geometriesCount];
+        for (size_t i = 0; i < desc.geometriesCount; ++i) {
+            const BLASGeometryDesc& geometry = desc.geometries[i];
+            auto* metalVertex = INTERPRET_AS<MetalBuffer*>(geometry.vertexBuffer);
+            auto* metalIndex = INTERPRET_AS<MetalBuffer*>(geometry.indexBuffer);
+            auto* metalTransform = INTERPRET_AS<MetalBuffer*>(geometry.transformBuffer);
+
+            auto triangleGeoDesc = [MTLAccelerationStructureTriangleGeometryDescriptor descriptor];
+            triangleGeoDesc.vertexBuffer = metalVertex->buffer;
+            triangleGeoDesc.vertexBufferOffset = geometry.vertexBufferStartOffset;
+            triangleGeoDesc.vertexFormat = Convert::ToMTLMTLAttributeFormat(geometry.vertexFormat);
+            triangleGeoDesc.vertexStride = geometry.vertexStride;
+            triangleGeoDesc.indexBuffer = metalIndex ? metalIndex->buffer : nil;
+            triangleGeoDesc.indexBufferOffset = metalIndex ? geometry.indexBufferStartOffset : 0;
+            triangleGeoDesc.indexType = Convert::ToMTLIndexType(geometry.indexFormat);
+            triangleGeoDesc.triangleCount = (metalIndex ? geometry.indexCount : geometry.vertexCount) / 3;
+            triangleGeoDesc.opaque = geometry.opaque;
+            triangleGeoDesc.primitiveDataBuffer = nil;
+            triangleGeoDesc.primitiveDataStride = 0;
+            triangleGeoDesc.primitiveDataElementSize = 0;
+            triangleGeoDesc.transformationMatrixBuffer = metalTransform ? metalTransform->buffer : nil;
+            triangleGeoDesc.transformationMatrixBufferOffset = metalTransform ? geometry.transformBufferStartOffset : 0;
+            triangleGeoDesc.intersectionFunctionTableOffset = 0; // TODO <- take from desc
+            triangleGeoDesc.label = [NSString stringWithUTF8String:name];
+            [geometryDescriptors addObject:triangleGeoDesc];
+        }
 
         auto accelerationStructureDescriptor = [MTLPrimitiveAccelerationStructureDescriptor descriptor];
         accelerationStructureDescriptor.geometryDescriptors = geometryDescriptors;
@@ -185,42 +257,103 @@ namespace RHINO::APIMetal {
 
         result->accelerationStructure = [m_Device newAccelerationStructureWithSize:sizes.accelerationStructureSize];
 
-        id<MTLAccelerationStructureCommandEncoder> encoder = [m_Cmd accelerationStructureCommandEncoder];
         [encoder buildAccelerationStructure:result->accelerationStructure
                                  descriptor:accelerationStructureDescriptor
-                              scratchBuffer:metalScratch->buffer
-                        scratchBufferOffset:scratchBufferStartOffset];
-        [encoder endEncoding];
+                              scratchBuffer:scratchBuffer
+                        scratchBufferOffset:scratchBufferOffset];
+        *outScratchSizeInBytes = RHINO_CEIL_TO_POWER_OF_TWO(sizes.buildScratchBufferSize, 256);
         return result;
     }
 
+    void MetalCommandList::QueryBLASCompactedSizes(size_t count, BLAS* const* blases) noexcept {
+        if (count == 0) {
+            return;
+        }
+
+        id<MTLBuffer> sizesBuffer = [m_Device newBufferWithLength:count * sizeof(uint32_t) options:MTLResourceStorageModeShared];
+        [sizesBuffer setLabel:@"BLASCompactedSizes"];
+
+        id<MTLAccelerationStructureCommandEncoder> encoder = [m_Cmd accelerationStructureCommandEncoder];
+        for (size_t i = 0; i < count; ++i) {
+            auto* metalBLAS = INTERPRET_AS<MetalBLAS*>(blases[i]);
+            metalBLAS->compactedSizeBuffer = sizesBuffer;
+            metalBLAS->compactedSizeIndex = i;
+            metalBLAS->compactedSizeCmd = m_Cmd;
+            [encoder writeCompactedAccelerationStructureSize:metalBLAS->accelerationStructure
+                                                    toBuffer:sizesBuffer
+                                                      offset:i * sizeof(uint32_t)];
+        }
+        [encoder endEncoding];
+    }
+
+    void MetalCommandList::CompactBLASes(size_t count, BLAS* const* blases, const char* name, BLAS** outCompacted) noexcept {
+        id<MTLAccelerationStructureCommandEncoder> encoder = [m_Cmd accelerationStructureCommandEncoder];
+        for (size_t i = 0; i < count; ++i) {
+            auto* source = INTERPRET_AS<MetalBLAS*>(blases[i]);
+            size_t compactedSize = 0;
+            const bool sizeReady = source->GetCompactedSize(&compactedSize);
+            assert(sizeReady && "BLAS compacted size is not read back yet.");
+            if (!sizeReady) {
+                compactedSize = source->accelerationStructure.size;
+            }
+
+            auto* result = new MetalBLAS{};
+            result->accelerationStructure = [m_Device newAccelerationStructureWithSize:compactedSize];
+            result->accelerationStructure.label = [NSString stringWithUTF8String:name];
+            [encoder copyAndCompactAccelerationStructure:source->accelerationStructure
+                                 toAccelerationStructure:result->accelerationStructure];
+
+            m_CompactedSources.push_back(source);
+            outCompacted[i] = result;
+        }
+        [encoder endEncoding];
+    }
+
+    void MetalCommandList::QueryBLASSerializedSizes(size_t count, BLAS* const* blases) noexcept {
+        // Metal has no acceleration structure serialization. MetalBackend::GetBLASSerializedSize reports size 0.
+    }
+
+    void MetalCommandList::SerializeBLAS(BLAS* blas, Buffer* dstBuffer, size_t dstBufferStartOffset) noexcept {
+        // NOOP, serialized size is always 0.
+    }
+
+    BLAS* MetalCommandList::DeserializeBLAS(const SerializedASInfo& info, Buffer* srcBuffer, size_t srcBufferStartOffset,
+                                            const char* name) noexcept {
+        // Blobs are never compatible, caller rebuilds the BLAS.
+        return nullptr;
+    }
+
     TLAS* MetalCommandList::BuildTLAS(const TLASDesc& desc, Buffer* scratchBuffer, size_t scratchBufferStartOffset,
                                       const char* name) noexcept {
         auto* result = new MetalTLAS{};
         auto* metalScratch = INTERPRET_AS<MetalBuffer*>(scratchBuffer);
 
-        id<MTLBuffer> instanceDescBuf = [m_Device newBufferWithLength:0 options:MTLResourceOptionCPUCacheModeDefault];
-
         auto asDescs = [NSMutableArray array];
         for (size_t i = 0; i < desc.blasInstancesCount; ++i) {
-            const BLASInstanceDesc& instance = desc.blasInstances[i];
-            auto* metalBLAS = INTERPRET_AS<MetalBLAS*>(instance.blas);
-            [asDescs addObject:metalBLAS->accelerationStructure];
+            auto* metalBLAS = INTERPRET_AS<MetalBLAS*>(desc.blasInstances[i].blas);
+            auto [_, inserted] = result->blasIndices.emplace(metalBLAS->accelerationStructure, result->blasIndices.size());
+            if (inserted) {
+                [asDescs addObject:metalBLAS->accelerationStructure];
+            }
         }
 
+        result->instancesCount = desc.blasInstancesCount;
+        MetalTLASInstanceBuffer* instanceBuffer = AcquireTLASInstanceBuffer(result);
+        WriteTLASInstances(result, instanceBuffer, desc);
+
         auto accelerationStructureDescriptor = [MTLInstanceAccelerationStructureDescriptor descriptor];
         accelerationStructureDescriptor.instanceCount = desc.blasInstancesCount;
         accelerationStructureDescriptor.instanceDescriptorType = MTLAccelerationStructureInstanceDescriptorTypeDefault;
         accelerationStructureDescriptor.instancedAccelerationStructures = asDescs;
-
-        accelerationStructureDescriptor.instanceDescriptorBuffer = instanceDescBuf;
+        accelerationStructureDescriptor.instanceDescriptorBuffer = instanceBuffer->buffer;
         accelerationStructureDescriptor.instanceDescriptorBufferOffset = 0;
-        accelerationStructureDescriptor.instanceDescriptorStride = 0;
-
-        // TODO: apply transform from desc
+        accelerationStructureDescriptor.instanceDescriptorStride = sizeof(MTLAccelerationStructureInstanceDescriptor);
+        accelerationStructureDescriptor.usage = desc.allowUpdate ? MTLAccelerationStructureUsageRefit : MTLAccelerationStructureUsageNone;
+        result->descriptor = accelerationStructureDescriptor;
 
         MTLAccelerationStructureSizes sizes = [m_Device accelerationStructureSizesWithDescriptor:accelerationStructureDescriptor];
         result->accelerationStructure = [m_Device newAccelerationStructureWithSize:sizes.accelerationStructureSize];
+        result->accelerationStructure.label = [NSString stringWithUTF8String:name];
 
         id<MTLAccelerationStructureCommandEncoder> encoder = [m_Cmd accelerationStructureCommandEncoder];
         [encoder buildAccelerationStructure:result->accelerationStructure
@@ -231,6 +364,74 @@ namespace RHINO::APIMetal {
         return result;
     }
 
+    void MetalCommandList::UpdateTLAS(TLAS* tlas, const TLASDesc& desc, Buffer* scratchBuffer, size_t scratchBufferStartOffset) noexcept {
+        auto* metalTLAS = INTERPRET_AS<MetalTLAS*>(tlas);
+        auto* metalScratch = INTERPRET_AS<MetalBuffer*>(scratchBuffer);
+        assert(metalTLAS->descriptor.usage & MTLAccelerationStructureUsageRefit && "TLAS was built without allowUpdate.");
+        assert(metalTLAS->instancesCount == desc.blasInstancesCount && "TLAS update can't change instances count.");
+
+        // Instances are written at encode time, so they go to a buffer that previously encoded builds do not read.
+        MetalTLASInstanceBuffer* instanceBuffer = AcquireTLASInstanceBuffer(metalTLAS);
+        WriteTLASInstances(metalTLAS, instanceBuffer, desc);
+        metalTLAS->descriptor.instanceDescriptorBuffer = instanceBuffer->buffer;
+
+        id<MTLAccelerationStructureCommandEncoder> encoder = [m_Cmd accelerationStructureCommandEncoder];
+        [encoder refitAccelerationStructure:metalTLAS->accelerationStructure
+                                 descriptor:metalTLAS->descriptor
+                                destination:nil
+                              scratchBuffer:metalScratch->buffer
+                        scratchBufferOffset:scratchBufferStartOffset];
+        [encoder endEncoding];
+    }
+
+    MetalTLASInstanceBuffer* MetalCommandList::AcquireTLASInstanceBuffer(MetalTLAS* tlas) noexcept {
+        MetalTLASInstanceBuffer* result = nullptr;
+        for (MetalTLASInstanceBuffer& instanceBuffer : tlas->instanceBuffers) {
+            if (instanceBuffer.IsIdle()) {
+                result = &instanceBuffer;
+                break;
+            }
+        }
+        if (!result) {
+            result = &tlas->instanceBuffers.emplace_back();
+            const size_t instancesSize = std::max<size_t>(tlas->instancesCount, 1) * sizeof(MTLAccelerationStructureInstanceDescriptor);
+            result->buffer = [m_Device newBufferWithLength:instancesSize options:MTLResourceStorageModeShared];
+            // Forces the first write of every instance.
+            result->instances.resize(tlas->instancesCount);
+            memset(result->instances.data(), 0xFF, result->instances.size() * sizeof(MTLAccelerationStructureInstanceDescriptor));
+        }
+        result->lastUse = m_Cmd;
+        return result;
+    }
+
+    void MetalCommandList::WriteTLASInstances(MetalTLAS* tlas, MetalTLASInstanceBuffer* instanceBuffer, const TLASDesc& desc) noexcept {
+        auto* mappedInstances = static_cast<MTLAccelerationStructureInstanceDescriptor*>(instanceBuffer->buffer.contents);
+        for (size_t i = 0; i < desc.blasInstancesCount; ++i) {
+            const BLASInstanceDesc& instanceDesc = desc.blasInstances[i];
+            auto* metalBLAS = INTERPRET_AS<MetalBLAS*>(instanceDesc.blas);
+            // Refit can't change the set of instanced BLASes.
+            auto blasIndex = tlas->blasIndices.find(metalBLAS->accelerationStructure);
+            assert(blasIndex != tlas->blasIndices.end() && "BLAS is not instanced by this TLAS.");
+
+            MTLAccelerationStructureInstanceDescriptor instance{};
+            // Metal packs transform by columns.
+            for (size_t column = 0; column < 4; ++column) {
+                for (size_t row = 0; row < 3; ++row) {
+                    instance.transformationMatrix.columns[column].elements[row] = instanceDesc.transform[row][column];
+                }
+            }
+            instance.options = MTLAccelerationStructureInstanceOptionNone;
+            instance.mask = instanceDesc.instanceMask;
+            instance.intersectionFunctionTableOffset = 0;
+            instance.accelerationStructureIndex = blasIndex->second;
+
+            if (memcmp(&instance, &instanceBuffer->instances[i], sizeof(instance)) != 0) {
+                instanceBuffer->instances[i] = instance;
+                mappedInstances[i] = instance;
+            }
+        }
+    }
+
     void MetalCommandList::DispatchRays(const DispatchRaysDesc& desc) noexcept {
         // m_RootSignaturesRingSyncWaitValue[m_CurrentRingRootSignatureIndex] += 1;
         // [encoder signal:m_RootSignaturesRingSync[m_CurrentRingRootSignatureIndex];
@@ -27,6 +27,8 @@ namespace RHINO::APIMetal {
 
         void WriteSMP(RHINO::Sampler *sampler, size_t offsetInHeap) noexcept final;
 
+        void Grow(size_t newDescriptorsCount) noexcept final;
+
     public:
         id<MTLBuffer> GetHeapBuffer() noexcept;
         size_t GetDescriptorStride() const noexcept;
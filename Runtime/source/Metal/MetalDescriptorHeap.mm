@@ -73,6 +73,21 @@ namespace RHINO::APIMetal {
         // m_Resources[offsetInHeap] = metalSampler->sampler;
     }
 
+    void MetalDescriptorHeap::Grow(size_t newDescriptorsCount) noexcept {
+        if (newDescriptorsCount <= m_Resources.size()) {
+            return;
+        }
+
+        // Command buffers retain referenced buffers, so the old heap lives until in-flight work completes.
+        id<MTLBuffer> newHeap = [[m_DescriptorHeap device] newBufferWithLength:sizeof(IRDescriptorTableEntry) * newDescriptorsCount
+                                                                       options:MTLResourceStorageModeShared];
+        [newHeap setLabel:[m_DescriptorHeap label]];
+        memcpy([newHeap contents], [m_DescriptorHeap contents], sizeof(IRDescriptorTableEntry) * m_Resources.size());
+
+        m_DescriptorHeap = newHeap;
+        m_Resources.resize(newDescriptorsCount);
+    }
+
     void MetalDescriptorHeap::Release() noexcept {
         delete this;
     }
@@ -12,10 +12,10 @@ inline bool WaitForMTLSharedEventValue(id<MTLSharedEvent> event, uint64_t value,
     } else {
         constexpr size_t SLEEP_SESSION_TIME_MS = 10;
         size_t totalWaited = 0;
-        while (event.signaledValue != value && totalWaited < timeoutMS) {
+        while (event.signaledValue < value && totalWaited < timeoutMS) {
             std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_SESSION_TIME_MS));
             totalWaited += SLEEP_SESSION_TIME_MS;
         }
-        return event.signaledValue == value;
+        return event.signaledValue >= value;
     }
 }
@@ -1,19 +1,41 @@
 #include "RHINOInterfaceImplBase.h"
+#include "FrameContextImpl.h"
 #include "SCARTools/SCARComputePSOArchiveView.h"
 #include "SCARTools/SCARRTPSOArchiveView.h"
 
 namespace RHINO {
     ComputePSO* RHINOInterfaceImplBase::CompileSCARComputePSO(const void* scar, uint32_t sizeInBytes, RootSignature* rootSignature,
-                                                              const char* debugName) noexcept {
-        const SCARTools::SCARComputePSOArchiveView view{scar, sizeInBytes, debugName};
+                                                              const char* debugName, size_t specializationConstantsCount,
+                                                              const SpecializationConstant* specializationConstants) noexcept {
+        SCARTools::SCARComputePSOArchiveView view{scar, sizeInBytes, debugName};
         if (!view.IsValid()) {
             return nullptr;
         }
+        view.OverrideSpecializationConstants(specializationConstantsCount, specializationConstants);
         ComputePSODesc desc = view.GetDesc();
         desc.rootSignature = rootSignature;
         return CompileComputePSO(desc);
     }
 
+    ComputePSO* RHINOInterfaceImplBase::CompileSCARComputePSOAsync(const void* scar, uint32_t sizeInBytes, RootSignature* rootSignature,
+                                                                   const char* debugName, size_t specializationConstantsCount,
+                                                                   const SpecializationConstant* specializationConstants) noexcept {
+        SCARTools::SCARComputePSOArchiveView view{scar, sizeInBytes, debugName};
+        if (!view.IsValid()) {
+            return nullptr;
+        }
+        view.OverrideSpecializationConstants(specializationConstantsCount, specializationConstants);
+        ComputePSODesc desc = view.GetDesc();
+        desc.rootSignature = rootSignature;
+        return CompileComputePSOAsync(desc);
+    }
+
+    void RHINOInterfaceImplBase::CompileComputePSOs(size_t count, const ComputePSODesc* descs, ComputePSO** outPSOs) noexcept {
+        for (size_t i = 0; i < count; ++i) {
+            outPSOs[i] = CompileComputePSO(descs[i]);
+        }
+    }
+
     RTPSO* RHINOInterfaceImplBase::CreateSCARRTPSO(const void* scar, uint32_t sizeInBytes, const RTPSODesc& desc) noexcept {
         const SCARTools::SCARRTPSOArchiveView view{scar, sizeInBytes, desc};
         if (!view.IsValid()) {
@@ -21,4 +43,8 @@ namespace RHINO {
         }
         return CreateRTPSO(view.GetPatchedDesc());
     }
+
+    FrameContext* RHINOInterfaceImplBase::CreateFrameContext(const FrameContextDesc& desc) noexcept {
+        return new FrameContextImpl{this, desc};
+    }
 } // RHINO
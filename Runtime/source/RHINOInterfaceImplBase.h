@@ -7,8 +7,14 @@ namespace RHINO {
 class RHINOInterfaceImplBase : public RHINOInterface {
 public:
     ComputePSO* CompileSCARComputePSO(const void* scar, uint32_t sizeInBytes, RootSignature* rootSignature,
-                                      const char* debugName) noexcept final;
+                                      const char* debugName, size_t specializationConstantsCount,
+                                      const SpecializationConstant* specializationConstants) noexcept final;
+    ComputePSO* CompileSCARComputePSOAsync(const void* scar, uint32_t sizeInBytes, RootSignature* rootSignature,
+                                           const char* debugName, size_t specializationConstantsCount,
+                                           const SpecializationConstant* specializationConstants) noexcept final;
+    void CompileComputePSOs(size_t count, const ComputePSODesc* descs, ComputePSO** outPSOs) noexcept override;
     RTPSO* CreateSCARRTPSO(const void* scar, uint32_t sizeInBytes, const RTPSODesc& desc) noexcept final;
+    FrameContext* CreateFrameContext(const FrameContextDesc& desc) noexcept final;
 };
 
 } // RHINO
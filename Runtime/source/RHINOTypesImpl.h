@@ -2,6 +2,8 @@
 
 #include "RHINOTypes.h"
 
+#include <atomic>
+
 namespace RHINO {
     class BufferBase : public Buffer {
     public:
@@ -20,6 +22,31 @@ namespace RHINO {
         ResourceType GetResourceType() final { return ResourceType::Sampler; }
     };
 
+    class ComputePSOBase : public ComputePSO {
+    public:
+        bool IsReady() noexcept final { return m_Ready.load(std::memory_order_acquire); }
+        void Wait() noexcept final { m_Ready.wait(false, std::memory_order_acquire); }
+        bool IsFailed() noexcept final { return m_Failed.load(std::memory_order_acquire); }
+        bool GetStatistics(PSOStatistics* outStatistics) noexcept override { return false; }
+        Dim3D GetWorkgroupSize() noexcept final { return m_WorkgroupSize; }
+        void SetWorkgroupSize(const Dim3D& workgroupSize) noexcept { m_WorkgroupSize = workgroupSize; }
+
+        void MarkPending() noexcept { m_Ready.store(false, std::memory_order_relaxed); }
+        void MarkReady() noexcept {
+            m_Ready.store(true, std::memory_order_release);
+            m_Ready.notify_all();
+        }
+        void MarkFailed() noexcept {
+            m_Failed.store(true, std::memory_order_release);
+            MarkReady();
+        }
+
+    private:
+        std::atomic<bool> m_Ready = true;
+        std::atomic<bool> m_Failed = false;
+        Dim3D m_WorkgroupSize = {};
+    };
+
     class BLASBase : public BLAS {
         ResourceType GetResourceType() final { return ResourceType::BLAS; }
     };
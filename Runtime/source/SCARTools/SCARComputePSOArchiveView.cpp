@@ -18,9 +18,44 @@ namespace RHINO::SCARTools {
         m_Desc.CS.bytecode = cs.data;
         m_Desc.CS.bytecodeSize = cs.dataSize;
 
+        if (reader.HasRecord(SCAR::RecordType::SpecializationConstants)) {
+            const SCAR::Record& constants = reader.GetRecord(SCAR::RecordType::SpecializationConstants);
+            const size_t constantsCount = constants.dataSize / sizeof(SCAR::SpecializationConstantItem);
+            for (size_t i = 0; i < constantsCount; ++i) {
+                SCAR::SpecializationConstantItem item{};
+                memcpy(&item, constants.data + i * sizeof(SCAR::SpecializationConstantItem), sizeof(SCAR::SpecializationConstantItem));
+                m_SpecializationConstants.push_back(SpecializationConstant{item.constantID, item.defaultValue});
+            }
+        }
+        m_Desc.specializationConstantsCount = m_SpecializationConstants.size();
+        m_Desc.specializationConstants = m_SpecializationConstants.data();
+
+        if (reader.HasRecord(SCAR::RecordType::WorkgroupSize)) {
+            const SCAR::Record& workgroupSizeRecord = reader.GetRecord(SCAR::RecordType::WorkgroupSize);
+            uint32_t workgroupSize[3] = {};
+            memcpy(workgroupSize, workgroupSizeRecord.data, std::min<size_t>(workgroupSizeRecord.dataSize, sizeof(workgroupSize)));
+            m_Desc.workgroupSize = {workgroupSize[0], workgroupSize[1], workgroupSize[2]};
+        }
+
         m_Desc.debugName = debugName;
     }
 
+    void SCARComputePSOArchiveView::OverrideSpecializationConstants(size_t count, const SpecializationConstant* constants) noexcept {
+        for (size_t i = 0; i < count; ++i) {
+            auto it = std::find_if(m_SpecializationConstants.begin(), m_SpecializationConstants.end(),
+                                   [&](const SpecializationConstant& c) { return c.constantID == constants[i].constantID; });
+            if (it != m_SpecializationConstants.end()) {
+                it->value = constants[i].value;
+            }
+            else {
+                // Archive may be produced without reflection data (e.g. DXIL).
+                m_SpecializationConstants.push_back(constants[i]);
+            }
+        }
+        m_Desc.specializationConstantsCount = m_SpecializationConstants.size();
+        m_Desc.specializationConstants = m_SpecializationConstants.data();
+    }
+
     const ComputePSODesc& SCARComputePSOArchiveView::GetDesc() const noexcept { return m_Desc; }
     bool SCARComputePSOArchiveView::IsValid() const noexcept { return m_IsValid; }
 } // namespace RHINO::SCARTools
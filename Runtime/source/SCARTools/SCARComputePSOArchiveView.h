@@ -6,8 +6,11 @@ namespace RHINO::SCARTools {
         explicit SCARComputePSOArchiveView(const void* archive, uint32_t sizeInBytes, const char* debugName) noexcept;
         const ComputePSODesc& GetDesc() const noexcept;
         bool IsValid() const noexcept;
+        // Replaces archived default values of constants with matching IDs.
+        void OverrideSpecializationConstants(size_t count, const SpecializationConstant* constants) noexcept;
     private:
         ComputePSODesc m_Desc{};
+        std::vector<SpecializationConstant> m_SpecializationConstants{};
         std::vector<DescriptorSpaceDesc> m_RootSignatureView{};
         bool m_IsValid = true;
     };
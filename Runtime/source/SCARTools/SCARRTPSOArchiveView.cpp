@@ -18,6 +18,7 @@ namespace RHINO::SCARTools {
 
         const SCAR::Record& libAss = reader.GetRecord(SCAR::RecordType::LibAssembly);
 
+        // All entrypoints reference the same library bytecode, backends create it once.
         for (const char* entry : reader.CreateEntrypointsView()) {
             ShaderModule shaderModule{};
             shaderModule.bytecodeSize = libAss.dataSize;
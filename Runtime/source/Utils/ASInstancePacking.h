@@ -0,0 +1,94 @@
+#pragma once
+
+namespace RHINO {
+    /**
+     * Native TLAS instance record. Layout matches VkAccelerationStructureInstanceKHR and D3D12_RAYTRACING_INSTANCE_DESC.
+     */
+    struct PackedASInstance {
+        float transform[3][4];
+        // Instance ID in low 24 bits, mask in high 8 bits.
+        uint32_t instanceIDAndMask;
+        // Hit group offset in low 24 bits, flags in high 8 bits.
+        uint32_t hitGroupOffsetAndFlags;
+        uint64_t blasAddress;
+    };
+    static_assert(sizeof(PackedASInstance) == 64);
+
+    inline uint32_t PackASInstanceIDAndMask(const BLASInstanceDesc& desc) noexcept {
+        return (desc.instanceID & 0xFFFFFFu) | ((desc.instanceMask & 0xFFu) << 24);
+    }
+
+    /**
+     * Converts instances to native records and writes changed ones to both shadow and dst.
+     * shadow is a cached host copy of dst, so dst, usually write combined memory, is never read.
+     * dst is written with non temporal stores and must be 32 bytes aligned. descs and shadow are read with unaligned loads.
+     * getBLASAddress returns GPU address of BLAS.
+     */
+    template<typename GetBLASAddress>
+    void PackASInstances(const BLASInstanceDesc* descs, size_t count, PackedASInstance* shadow, PackedASInstance* dst,
+                         GetBLASAddress getBLASAddress) noexcept {
+        assert(reinterpret_cast<uintptr_t>(dst) % 32 == 0 && "Instance records destination is not aligned.");
+
+        for (size_t i = 0; i < count; ++i) {
+            const BLASInstanceDesc& desc = descs[i];
+            const uint64_t header = PackASInstanceIDAndMask(desc);
+            const uint64_t blasAddress = getBLASAddress(desc.blas);
+
+#if defined(__AVX2__)
+            // Two 32 bytes halves: rows 0-1, then row 2 with header and BLAS address.
+            const __m128i row2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(desc.transform[2]));
+            const __m128i tail = _mm_set_epi64x(static_cast<long long>(blasAddress), static_cast<long long>(header));
+            const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(desc.transform[0]));
+            const __m256i hi = _mm256_set_m128i(tail, row2);
+
+            auto* shadowRecord = reinterpret_cast<__m256i*>(&shadow[i]);
+            const __m256i equal = _mm256_and_si256(_mm256_cmpeq_epi8(lo, _mm256_loadu_si256(shadowRecord)),
+                                                   _mm256_cmpeq_epi8(hi, _mm256_loadu_si256(shadowRecord + 1)));
+            if (_mm256_movemask_epi8(equal) == -1) {
+                continue;
+            }
+            _mm256_storeu_si256(shadowRecord, lo);
+            _mm256_storeu_si256(shadowRecord + 1, hi);
+            auto* dstRecord = reinterpret_cast<__m256i*>(&dst[i]);
+            _mm256_stream_si256(dstRecord, lo);
+            _mm256_stream_si256(dstRecord + 1, hi);
+#elif defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+            const __m128i record[4] = {
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(desc.transform[0])),
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(desc.transform[1])),
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(desc.transform[2])),
+                    _mm_set_epi64x(static_cast<long long>(blasAddress), static_cast<long long>(header)),
+            };
+
+            auto* shadowRecord = reinterpret_cast<__m128i*>(&shadow[i]);
+            __m128i equal = _mm_cmpeq_epi8(record[0], _mm_loadu_si128(shadowRecord));
+            for (size_t j = 1; j < 4; ++j) {
+                equal = _mm_and_si128(equal, _mm_cmpeq_epi8(record[j], _mm_loadu_si128(shadowRecord + j)));
+            }
+            if (_mm_movemask_epi8(equal) == 0xFFFF) {
+                continue;
+            }
+            auto* dstRecord = reinterpret_cast<__m128i*>(&dst[i]);
+            for (size_t j = 0; j < 4; ++j) {
+                _mm_storeu_si128(shadowRecord + j, record[j]);
+                _mm_stream_si128(dstRecord + j, record[j]);
+            }
+#else
+            PackedASInstance record{};
+            memcpy(record.transform, desc.transform, sizeof(desc.transform));
+            record.instanceIDAndMask = static_cast<uint32_t>(header);
+            record.hitGroupOffsetAndFlags = 0;
+            record.blasAddress = blasAddress;
+            if (memcmp(&record, &shadow[i], sizeof(record)) != 0) {
+                shadow[i] = record;
+                dst[i] = record;
+            }
+#endif
+        }
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+        // Non temporal stores are weakly ordered, make them visible before the build is submitted.
+        _mm_sfence();
+#endif
+    }
+}// namespace RHINO
@@ -10,6 +10,54 @@ namespace RHINO {
         return static_cast<OutT>(obj);
     }
 
+    template<typename T>
+    void HashCombine(size_t& seed, const T& value) noexcept {
+        seed ^= std::hash<T>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+
+    // Hints CPU that calling thread is in a spin wait loop.
+    inline void CPUPause() noexcept {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#elif defined(__aarch64__) && defined(__clang__)
+        __builtin_arm_yield();
+#endif
+    }
+
+    // Polls isReached for up to min(spinTimeInMicroseconds, timeout). Returns true as soon as isReached does.
+    // Timeout is measured in TimeoutPeriod units, time spent spinning is subtracted from it for following blocking wait.
+    // Zero timeout is not spun on, timeout not less than infiniteTimeout is left as is.
+    template<typename TimeoutPeriod, typename Predicate>
+    bool SpinWait(size_t spinTimeInMicroseconds, size_t& timeout, size_t infiniteTimeout, Predicate isReached) noexcept {
+        using TimeoutDuration = std::chrono::duration<size_t, TimeoutPeriod>;
+        const bool isInfinite = timeout >= infiniteTimeout;
+        auto spinTime = std::chrono::microseconds(spinTimeInMicroseconds);
+        if (!isInfinite && std::chrono::ceil<TimeoutDuration>(spinTime).count() > timeout) {
+            spinTime = std::chrono::duration_cast<std::chrono::microseconds>(TimeoutDuration(timeout));
+        }
+        if (spinTime.count() <= 0) {
+            return false;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto deadline = start + spinTime;
+        bool reached = false;
+        do {
+            reached = isReached();
+            if (reached) {
+                break;
+            }
+            CPUPause();
+        } while (std::chrono::steady_clock::now() < deadline);
+        reached = reached || isReached();
+
+        if (!reached && !isInfinite) {
+            const size_t spent = std::chrono::duration_cast<TimeoutDuration>(std::chrono::steady_clock::now() - start).count();
+            timeout -= std::min(spent, timeout);
+        }
+        return reached;
+    }
+
 #ifdef __clang__
     template<typename T>
     void UnusedVarHelper(const T& var __attribute__((unused))){};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
+namespace RHINO {
+    /**
+     * Fixed size pool of worker threads executing tasks in submission order.
+     */
+    class ThreadPool {
+    public:
+        using Task = std::function<void()>;
+
+    public:
+        void Initialize(size_t threadsCount) noexcept {
+            m_Stop = false;
+            m_Workers.reserve(threadsCount);
+            for (size_t i = 0; i < threadsCount; ++i) {
+                m_Workers.emplace_back([this]() { WorkerLoop(); });
+            }
+        }
+
+        void Release() noexcept {
+            {
+                std::lock_guard lock{m_Mutex};
+                m_Stop = true;
+            }
+            m_TaskAdded.notify_all();
+            for (std::thread& worker : m_Workers) {
+                worker.join();
+            }
+            m_Workers.clear();
+        }
+
+        void Enqueue(Task task) noexcept {
+            {
+                std::lock_guard lock{m_Mutex};
+                m_Tasks.push_back(std::move(task));
+            }
+            m_TaskAdded.notify_one();
+        }
+
+        [[nodiscard]] size_t GetThreadsCount() const noexcept {
+            return m_Workers.size();
+        }
+
+        static size_t GetDefaultThreadsCount() noexcept {
+            const size_t hardwareThreads = std::thread::hardware_concurrency();
+            return hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+        }
+
+    private:
+        void WorkerLoop() noexcept {
+            while (true) {
+                Task task;
+                {
+                    std::unique_lock lock{m_Mutex};
+                    m_TaskAdded.wait(lock, [this]() { return m_Stop || !m_Tasks.empty(); });
+                    // Pending tasks are drained before stop so that every handed out PSO becomes ready.
+                    if (m_Tasks.empty()) {
+                        return;
+                    }
+                    task = std::move(m_Tasks.front());
+                    m_Tasks.pop_front();
+                }
+                task();
+            }
+        }
+
+    private:
+        std::mutex m_Mutex{};
+        std::condition_variable m_TaskAdded{};
+        std::deque<Task> m_Tasks{};
+        std::vector<std::thread> m_Workers{};
+        bool m_Stop = false;
+    };
+} // namespace RHINO
@@ -17,9 +17,19 @@
     RHINO_APPLY(vkCreateAccelerationStructureKHR)                                                                                          \
     RHINO_APPLY(vkDestroyAccelerationStructureKHR)                                                                                         \
     RHINO_APPLY(vkCmdBuildAccelerationStructuresKHR)                                                                                       \
+    RHINO_APPLY(vkGetAccelerationStructureDeviceAddressKHR)                                                                                \
+    RHINO_APPLY(vkCmdWriteAccelerationStructuresPropertiesKHR)                                                                             \
+    RHINO_APPLY(vkCmdCopyAccelerationStructureKHR)                                                                                         \
+    RHINO_APPLY(vkCmdCopyAccelerationStructureToMemoryKHR)                                                                                 \
+    RHINO_APPLY(vkCmdCopyMemoryToAccelerationStructureKHR)                                                                                 \
+    RHINO_APPLY(vkGetDeviceAccelerationStructureCompatibilityKHR)                                                                          \
     RHINO_APPLY(vkCmdTraceRaysKHR)                                                                                                         \
+    RHINO_APPLY(vkCreateRayTracingPipelinesKHR)                                                                                            \
+    RHINO_APPLY(vkGetRayTracingShaderGroupHandlesKHR)                                                                                      \
     RHINO_APPLY(vkSetDebugUtilsObjectNameEXT)                                                                                              \
-    RHINO_APPLY(vkGetDescriptorSetLayoutSizeEXT)
+    RHINO_APPLY(vkGetDescriptorSetLayoutSizeEXT)                                                                                           \
+    RHINO_APPLY(vkGetPipelineExecutablePropertiesKHR)                                                                                      \
+    RHINO_APPLY(vkGetPipelineExecutableStatisticsKHR)
 
 
 namespace RHINO::APIVulkan {
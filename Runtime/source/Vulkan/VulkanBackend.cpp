@@ -8,8 +8,85 @@
 #include "VulkanUtils.h"
 #include "VulkanConverters.h"
 
+#include <latch>
+
 namespace RHINO::APIVulkan {
-    void VulkanBackend::Initialize() noexcept {
+    // Statistic names are driver specific, common values are matched by well known name fragments.
+    static void MatchCommonStatistic(std::string name, double value, PSOStatistics* outStatistics) noexcept {
+        std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+        const auto has = [&](const char* fragment) { return name.find(fragment) != std::string::npos; };
+        const auto count = static_cast<uint32_t>(value);
+
+        if (has("spill")) {
+            outStatistics->spillsCount += count;
+        }
+        else if (has("sgpr")) {
+            outStatistics->scalarRegistersCount = std::max(outStatistics->scalarRegistersCount, count);
+        }
+        else if (has("vgpr") || has("register") || has("grf")) {
+            outStatistics->vectorRegistersCount = std::max(outStatistics->vectorRegistersCount, count);
+        }
+        else if (has("lds") || has("shared memory") || has("workgroup memory")) {
+            outStatistics->sharedMemorySizeInBytes = std::max(outStatistics->sharedMemorySizeInBytes, count);
+        }
+    }
+
+    bool VulkanComputePSO::GetStatistics(PSOStatistics* outStatistics) noexcept {
+        Wait();
+        if (!statisticsCaptured || PSO == VK_NULL_HANDLE) {
+            return false;
+        }
+        *outStatistics = {};
+
+        VkPipelineInfoKHR pipelineInfo{VK_STRUCTURE_TYPE_PIPELINE_INFO_KHR};
+        pipelineInfo.pipeline = PSO;
+        uint32_t executablesCount = 0;
+        RHINO_VKS(EXT::vkGetPipelineExecutablePropertiesKHR(context.device, &pipelineInfo, &executablesCount, nullptr));
+        std::vector<VkPipelineExecutablePropertiesKHR> executables(executablesCount, {VK_STRUCTURE_TYPE_PIPELINE_EXECUTABLE_PROPERTIES_KHR});
+        RHINO_VKS(EXT::vkGetPipelineExecutablePropertiesKHR(context.device, &pipelineInfo, &executablesCount, executables.data()));
+
+        for (uint32_t executable = 0; executable < executablesCount; ++executable) {
+            outStatistics->subgroupSize = std::max(outStatistics->subgroupSize, executables[executable].subgroupSize);
+
+            VkPipelineExecutableInfoKHR executableInfo{VK_STRUCTURE_TYPE_PIPELINE_EXECUTABLE_INFO_KHR};
+            executableInfo.pipeline = PSO;
+            executableInfo.executableIndex = executable;
+            uint32_t statisticsCount = 0;
+            RHINO_VKS(EXT::vkGetPipelineExecutableStatisticsKHR(context.device, &executableInfo, &statisticsCount, nullptr));
+            std::vector<VkPipelineExecutableStatisticKHR> statistics(statisticsCount, {VK_STRUCTURE_TYPE_PIPELINE_EXECUTABLE_STATISTIC_KHR});
+            RHINO_VKS(EXT::vkGetPipelineExecutableStatisticsKHR(context.device, &executableInfo, &statisticsCount, statistics.data()));
+
+            for (const VkPipelineExecutableStatisticKHR& statistic : statistics) {
+                double value = 0.0;
+                switch (statistic.format) {
+                    case VK_PIPELINE_EXECUTABLE_STATISTIC_FORMAT_BOOL32_KHR:
+                        value = statistic.value.b32 ? 1.0 : 0.0;
+                        break;
+                    case VK_PIPELINE_EXECUTABLE_STATISTIC_FORMAT_INT64_KHR:
+                        value = static_cast<double>(statistic.value.i64);
+                        break;
+                    case VK_PIPELINE_EXECUTABLE_STATISTIC_FORMAT_UINT64_KHR:
+                        value = static_cast<double>(statistic.value.u64);
+                        break;
+                    case VK_PIPELINE_EXECUTABLE_STATISTIC_FORMAT_FLOAT64_KHR:
+                        value = statistic.value.f64;
+                        break;
+                    default:
+                        break;
+                }
+                MatchCommonStatistic(statistic.name, value, outStatistics);
+
+                if (outStatistics->statisticsCount < PSOStatistics::MaxStatisticsCount) {
+                    PSOStatistic& out = outStatistics->statistics[outStatistics->statisticsCount++];
+                    strncpy(out.name, statistic.name, sizeof(out.name) - 1);
+                    out.value = value;
+                }
+            }
+        }
+        return true;
+    }
+
+    void VulkanBackend::Initialize(const InitializeDesc& desc) noexcept {
         VkApplicationInfo appInfo{VK_STRUCTURE_TYPE_APPLICATION_INFO};
         appInfo.apiVersion = VK_API_VERSION_1_3;
         appInfo.engineVersion = VK_MAKE_VERSION(0, 1, 0);
@@ -58,6 +135,7 @@ namespace RHINO::APIVulkan {
         physicalDeviceVulkan12Features.descriptorIndexing = VK_TRUE;
         physicalDeviceVulkan12Features.descriptorBindingVariableDescriptorCount = VK_TRUE;
         physicalDeviceVulkan12Features.timelineSemaphore = VK_TRUE;
+        physicalDeviceVulkan12Features.hostQueryReset = VK_TRUE;
 
         VkPhysicalDeviceMutableDescriptorTypeFeaturesEXT deviceMutableDescriptorTypeFeaturesEXT{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MUTABLE_DESCRIPTOR_TYPE_FEATURES_EXT};
         deviceMutableDescriptorTypeFeaturesEXT.pNext = &physicalDeviceVulkan12Features;
@@ -72,16 +150,71 @@ namespace RHINO::APIVulkan {
         deviceFeatures2.pNext = &deviceDescriptorBufferFeaturesExt;
         deviceFeatures2.features = {};
 
-        VkDeviceCreateInfo deviceInfo{VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO};
-        deviceInfo.pNext = &deviceFeatures2;
-        const char* deviceExtensions[] = {
+        std::vector<const char*> deviceExtensions = {
             VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME,
             VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME,
             VK_EXT_MUTABLE_DESCRIPTOR_TYPE_EXTENSION_NAME,
             VK_KHR_SWAPCHAIN_EXTENSION_NAME,
         };
-        deviceInfo.enabledExtensionCount = RHINO_ARR_SIZE(deviceExtensions);
-        deviceInfo.ppEnabledExtensionNames = deviceExtensions;
+
+        VkPhysicalDevicePipelineExecutablePropertiesFeaturesKHR pipelineExecutablePropertiesFeatures{
+                VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PIPELINE_EXECUTABLE_PROPERTIES_FEATURES_KHR};
+        m_CapturePSOStatistics = desc.capturePSOStatistics &&
+                                 IsDeviceExtensionSupported(VK_KHR_PIPELINE_EXECUTABLE_PROPERTIES_EXTENSION_NAME);
+        if (m_CapturePSOStatistics) {
+            deviceExtensions.push_back(VK_KHR_PIPELINE_EXECUTABLE_PROPERTIES_EXTENSION_NAME);
+            pipelineExecutablePropertiesFeatures.pipelineExecutableInfo = VK_TRUE;
+            pipelineExecutablePropertiesFeatures.pNext = deviceFeatures2.pNext;
+            deviceFeatures2.pNext = &pipelineExecutablePropertiesFeatures;
+        }
+
+        VkPhysicalDeviceAccelerationStructureFeaturesKHR accelerationStructureFeatures{
+                VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_FEATURES_KHR};
+        VkPhysicalDeviceRayTracingPipelineFeaturesKHR rayTracingPipelineFeatures{
+                VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_TRACING_PIPELINE_FEATURES_KHR};
+        VkPhysicalDeviceRayQueryFeaturesKHR rayQueryFeatures{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_QUERY_FEATURES_KHR};
+        const bool asSupported = IsDeviceExtensionSupported(VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME) &&
+                                 IsDeviceExtensionSupported(VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME);
+        m_RayTracingSupported = asSupported && IsDeviceExtensionSupported(VK_KHR_RAY_TRACING_PIPELINE_EXTENSION_NAME);
+        // Inline ray tracing does not need ray tracing pipelines, so it is enabled on its own.
+        m_RayQuerySupported = asSupported && IsDeviceExtensionSupported(VK_KHR_RAY_QUERY_EXTENSION_NAME);
+        m_Context.accelerationStructures = m_RayTracingSupported || m_RayQuerySupported;
+        if (m_Context.accelerationStructures) {
+            deviceExtensions.push_back(VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME);
+            deviceExtensions.push_back(VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME);
+            accelerationStructureFeatures.accelerationStructure = VK_TRUE;
+            accelerationStructureFeatures.pNext = deviceFeatures2.pNext;
+            deviceFeatures2.pNext = &accelerationStructureFeatures;
+
+            m_ASProps = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_PROPERTIES_KHR};
+            VkPhysicalDeviceProperties2 props{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2};
+            props.pNext = &m_ASProps;
+            vkGetPhysicalDeviceProperties2(m_Context.physicalDevice, &props);
+            m_ASProps.pNext = nullptr;
+        }
+        if (m_RayTracingSupported) {
+            deviceExtensions.push_back(VK_KHR_RAY_TRACING_PIPELINE_EXTENSION_NAME);
+            rayTracingPipelineFeatures.rayTracingPipeline = VK_TRUE;
+            rayTracingPipelineFeatures.pNext = deviceFeatures2.pNext;
+            deviceFeatures2.pNext = &rayTracingPipelineFeatures;
+
+            m_RayTracingProps = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_TRACING_PIPELINE_PROPERTIES_KHR};
+            VkPhysicalDeviceProperties2 props{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2};
+            props.pNext = &m_RayTracingProps;
+            vkGetPhysicalDeviceProperties2(m_Context.physicalDevice, &props);
+            m_RayTracingProps.pNext = nullptr;
+        }
+        if (m_RayQuerySupported) {
+            deviceExtensions.push_back(VK_KHR_RAY_QUERY_EXTENSION_NAME);
+            rayQueryFeatures.rayQuery = VK_TRUE;
+            rayQueryFeatures.pNext = deviceFeatures2.pNext;
+            deviceFeatures2.pNext = &rayQueryFeatures;
+        }
+
+        VkDeviceCreateInfo deviceInfo{VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO};
+        deviceInfo.pNext = &deviceFeatures2;
+        deviceInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
+        deviceInfo.ppEnabledExtensionNames = deviceExtensions.data();
         deviceInfo.queueCreateInfoCount = queueInfosCount;
         deviceInfo.pQueueCreateInfos = queueInfos;
         RHINO_VKS(vkCreateDevice(m_Context.physicalDevice, &deviceInfo, m_Context.allocator, &m_Context.device));
@@ -94,127 +227,247 @@ namespace RHINO::APIVulkan {
         //TODO: fix (get real mapping)
         vkGetDeviceQueue(m_Context.device, m_AsyncComputeQueueFamIndex, 0, &m_AsyncComputeQueue);
         vkGetDeviceQueue(m_Context.device, m_CopyQueueFamIndex, 0, &m_CopyQueue);
+
+        m_HostWaitSpinTimeInMicroseconds = desc.hostWaitSpinTimeInMicroseconds;
+        m_GarbageCollector.Initialize(m_Context);
+        m_SemaphoreWaiter.Initialize(m_Context);
+        m_SamplerCache.Initialize(m_Context);
+        m_RootSignatureCache.Initialize(m_Context);
+        m_PipelineCache.Initialize(m_Context, desc.psoCachePath);
+        m_ShaderModuleCache.Initialize(m_Context);
+        m_PSOCompilationPool.Initialize(ThreadPool::GetDefaultThreadsCount());
     }
 
     void VulkanBackend::Release() noexcept {
+        m_PSOCompilationPool.Release();
+        m_SemaphoreWaiter.Release();
+        m_GarbageCollector.Release();
+        m_SamplerCache.Release();
+        m_RootSignatureCache.Release();
+        m_PipelineCache.Release();
+        m_ShaderModuleCache.Release();
         vkDestroyDevice(m_Context.device, m_Context.allocator);
         vkDestroyInstance(m_Context.instance, m_Context.allocator);
     }
 
     RootSignature* VulkanBackend::SerializeRootSignature(const RootSignatureDesc& desc) noexcept {
-        auto result = new VulkanRootSignature{};
+        return m_RootSignatureCache.AcquireRootSignature(desc);
+    }
+
+    RTPSO* VulkanBackend::CreateRTPSO(const RTPSODesc& desc) noexcept {
+        assert(m_RayTracingSupported && "Device does not support ray tracing pipelines.");
+        if (!m_RayTracingSupported) {
+            return nullptr;
+        }
+        auto* vulkanRootSignature = INTERPRET_AS<VulkanRootSignature*>(desc.rootSignature);
+
+        auto* result = new VulkanRTPSO{};
         result->context = m_Context;
 
-        std::map<size_t, size_t> highestBindingPerSpace{};
-        for (size_t spaceIdx = 0; spaceIdx < desc.spacesCount; ++spaceIdx) {
-            for (size_t i = 0; i < desc.spacesDescs[spaceIdx].rangeDescCount; ++i) {
-                const DescriptorRangeDesc& range = desc.spacesDescs[spaceIdx].rangeDescs[i];
-                const size_t binding = range.baseRegisterSlot + range.descriptorsCount;
-                if (highestBindingPerSpace.contains(spaceIdx)) {
-                    highestBindingPerSpace[spaceIdx] = std::max(highestBindingPerSpace[spaceIdx], binding);
-                } else {
-                    highestBindingPerSpace[spaceIdx] = binding;
-                }
+        // Stage of the shader module is defined by records referencing it.
+        std::vector<VkShaderStageFlagBits> moduleStages(desc.shaderModulesCount, VK_SHADER_STAGE_RAYGEN_BIT_KHR);
+        for (size_t i = 0; i < desc.recordsCount; ++i) {
+            const RTShaderTableRecord& record = desc.records[i];
+            switch (record.recordType) {
+                case RTShaderTableRecordType::RayGeneration:
+                    moduleStages[record.rayGeneration.rayGenerationShaderIndex] = VK_SHADER_STAGE_RAYGEN_BIT_KHR;
+                    break;
+                case RTShaderTableRecordType::Miss:
+                    moduleStages[record.miss.missShaderIndex] = VK_SHADER_STAGE_MISS_BIT_KHR;
+                    break;
+                case RTShaderTableRecordType::HitGroup:
+                    if (record.hitGroup.clothestHitShaderEnabled)
+                        moduleStages[record.hitGroup.closestHitShaderIndex] = VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR;
+                    if (record.hitGroup.anyHitShaderEnabled)
+                        moduleStages[record.hitGroup.anyHitShaderIndex] = VK_SHADER_STAGE_ANY_HIT_BIT_KHR;
+                    if (record.hitGroup.intersectionShaderEnabled)
+                        moduleStages[record.hitGroup.intersectionShaderIndex] = VK_SHADER_STAGE_INTERSECTION_BIT_KHR;
+                    break;
             }
         }
 
-        std::vector<VkDescriptorSetLayout> spaceLayouts{};
-        spaceLayouts.resize(desc.spacesCount);
-        for (size_t spaceIdx = 0; spaceIdx < desc.spacesCount; ++spaceIdx) {
-            const DescriptorSpaceDesc& spaceDesc = desc.spacesDescs[spaceIdx];
-
-            const auto heapOffsetInDescriptors = std::make_pair(spaceDesc.spaceType, spaceDesc.offsetInDescriptorsFromTableStart);
-            result->heapOffsetsInDescriptorsBySpace[spaceIdx] = heapOffsetInDescriptors;
+        // Library entrypoints share bytecode, so one module is created per library and referenced by all its stages.
+        std::unordered_map<const uint8_t*, VulkanShaderModule*> libraryModules{};
+        std::vector<VkPipelineShaderStageCreateInfo> stages(desc.shaderModulesCount);
+        for (size_t i = 0; i < desc.shaderModulesCount; ++i) {
+            const ShaderModule& shaderModule = desc.shaderModules[i];
+            VulkanShaderModule*& libraryModule = libraryModules[shaderModule.bytecode];
+            if (!libraryModule) {
+                libraryModule = m_ShaderModuleCache.AcquireShaderModule(shaderModule.bytecode, shaderModule.bytecodeSize);
+                result->shaderModules.push_back(libraryModule);
+            }
 
-            std::vector<VkDescriptorSetLayoutBinding> bindings{};
-            bindings.resize(highestBindingPerSpace[spaceIdx] + 1);
+            VkPipelineShaderStageCreateInfo& stageInfo = stages[i];
+            stageInfo = {VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO};
+            stageInfo.module = libraryModule->shaderModule;
+            stageInfo.stage = moduleStages[i];
+            stageInfo.pName = shaderModule.entrypoint;
+        }
 
-            // Fill binding to highest bind slot with sampler / mutable descriptor desc.
-            VkMutableDescriptorTypeListEXT fillMutTypeList;
-            if (spaceDesc.spaceType == DescriptorHeapType::Sampler) {
-                for (uint32_t i = 0; i < bindings.size(); ++i) {
-                    bindings[i] = VkDescriptorSetLayoutBinding{i, VK_DESCRIPTOR_TYPE_SAMPLER, 1,
-                                                               VK_SHADER_STAGE_COMPUTE_BIT, nullptr};
-                }
-                fillMutTypeList = VkMutableDescriptorTypeListEXT{0, nullptr};
-            }
-            else {
-                for (uint32_t i = 0; i < bindings.size(); ++i) {
-                    bindings[i] = VkDescriptorSetLayoutBinding{i, VK_DESCRIPTOR_TYPE_MUTABLE_EXT, 1,
-                                                               VK_SHADER_STAGE_COMPUTE_BIT, nullptr};
-                }
-                fillMutTypeList = VkMutableDescriptorTypeListEXT{RHINO_ARR_SIZE(VulkanDescriptorHeap::CDBSRVUAVTypes),
-                                                                 VulkanDescriptorHeap::CDBSRVUAVTypes};
-            }
-            std::vector<VkMutableDescriptorTypeListEXT> mutableDescriptorTypeLists{};
-            mutableDescriptorTypeLists.resize(bindings.size(), fillMutTypeList);
-
-
-            VkMutableDescriptorTypeCreateInfoEXT mutableDescriptorTypeCreateInfoExt{
-                VK_STRUCTURE_TYPE_MUTABLE_DESCRIPTOR_TYPE_CREATE_INFO_EXT};
-            mutableDescriptorTypeCreateInfoExt.mutableDescriptorTypeListCount = mutableDescriptorTypeLists.size();
-            mutableDescriptorTypeCreateInfoExt.pMutableDescriptorTypeLists = mutableDescriptorTypeLists.data();
-
-            VkDescriptorSetLayoutCreateInfo setLayoutCreateInfo{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO};
-            setLayoutCreateInfo.pNext = spaceDesc.spaceType == DescriptorHeapType::Sampler ? nullptr : &mutableDescriptorTypeCreateInfoExt;
-            setLayoutCreateInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_DESCRIPTOR_BUFFER_BIT_EXT;
-            // setLayoutCreateInfo.flags = isSamplerSpace ? 0 : VK_DESCRIPTOR_SET_LAYOUT_CREATE_DESCRIPTOR_BUFFER_BIT_EXT;
-            setLayoutCreateInfo.bindingCount = bindings.size();
-            setLayoutCreateInfo.pBindings = bindings.data();
-
-            vkCreateDescriptorSetLayout(m_Context.device, &setLayoutCreateInfo, m_Context.allocator, &spaceLayouts[spaceIdx]);
-
-            VkDeviceSize debugSize = 0;
-            EXT::vkGetDescriptorSetLayoutSizeEXT(m_Context.device, spaceLayouts[spaceIdx], &debugSize);
-            std::cout << "Set " << spaceIdx << " size: " << debugSize << "\n";
-            for (size_t bnd = 0; bnd < bindings.size(); ++bnd) {
-                VkDeviceSize debugOffset = 0;
-                EXT::vkGetDescriptorSetLayoutBindingOffsetEXT(m_Context.device, spaceLayouts[spaceIdx], bnd, &debugOffset);
-                std::cout << "  Binding " << bnd << " off: " << debugOffset << std::endl;
+        // One shader group per record. Group index matches record index in shader table.
+        std::vector<VkRayTracingShaderGroupCreateInfoKHR> groups(desc.recordsCount);
+        for (size_t i = 0; i < desc.recordsCount; ++i) {
+            const RTShaderTableRecord& record = desc.records[i];
+            VkRayTracingShaderGroupCreateInfoKHR& group = groups[i];
+            group = {VK_STRUCTURE_TYPE_RAY_TRACING_SHADER_GROUP_CREATE_INFO_KHR};
+            group.generalShader = VK_SHADER_UNUSED_KHR;
+            group.closestHitShader = VK_SHADER_UNUSED_KHR;
+            group.anyHitShader = VK_SHADER_UNUSED_KHR;
+            group.intersectionShader = VK_SHADER_UNUSED_KHR;
+            switch (record.recordType) {
+                case RTShaderTableRecordType::RayGeneration:
+                    group.type = VK_RAY_TRACING_SHADER_GROUP_TYPE_GENERAL_KHR;
+                    group.generalShader = static_cast<uint32_t>(record.rayGeneration.rayGenerationShaderIndex);
+                    break;
+                case RTShaderTableRecordType::Miss:
+                    group.type = VK_RAY_TRACING_SHADER_GROUP_TYPE_GENERAL_KHR;
+                    group.generalShader = static_cast<uint32_t>(record.miss.missShaderIndex);
+                    break;
+                case RTShaderTableRecordType::HitGroup:
+                    group.type = record.hitGroup.intersectionShaderEnabled ? VK_RAY_TRACING_SHADER_GROUP_TYPE_PROCEDURAL_HIT_GROUP_KHR
+                                                                           : VK_RAY_TRACING_SHADER_GROUP_TYPE_TRIANGLES_HIT_GROUP_KHR;
+                    if (record.hitGroup.clothestHitShaderEnabled)
+                        group.closestHitShader = static_cast<uint32_t>(record.hitGroup.closestHitShaderIndex);
+                    if (record.hitGroup.anyHitShaderEnabled)
+                        group.anyHitShader = static_cast<uint32_t>(record.hitGroup.anyHitShaderIndex);
+                    if (record.hitGroup.intersectionShaderEnabled)
+                        group.intersectionShader = static_cast<uint32_t>(record.hitGroup.intersectionShaderIndex);
+                    break;
             }
         }
 
-        VkPipelineLayoutCreateInfo layoutInfo{VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO};
-        layoutInfo.pushConstantRangeCount = 0;
-        layoutInfo.setLayoutCount = spaceLayouts.size();
-        layoutInfo.pSetLayouts = spaceLayouts.data();
-        vkCreatePipelineLayout(m_Context.device, &layoutInfo, m_Context.allocator, &result->layout);
+        // Payload and attribute sizes are declared in SPIR-V, Vulkan needs them only for pipeline libraries.
+        VkRayTracingPipelineCreateInfoKHR createInfo{VK_STRUCTURE_TYPE_RAY_TRACING_PIPELINE_CREATE_INFO_KHR};
+        createInfo.flags = VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT;
+        createInfo.stageCount = static_cast<uint32_t>(stages.size());
+        createInfo.pStages = stages.data();
+        createInfo.groupCount = static_cast<uint32_t>(groups.size());
+        createInfo.pGroups = groups.data();
+        createInfo.maxPipelineRayRecursionDepth = std::min(desc.maxTraceRecursionDepth, m_RayTracingProps.maxRayRecursionDepth);
+        createInfo.layout = vulkanRootSignature->layout;
+        RHINO_VKS(EXT::vkCreateRayTracingPipelinesKHR(m_Context.device, VK_NULL_HANDLE, m_PipelineCache.GetPipelineCache(), 1, &createInfo,
+                                                      m_Context.allocator, &result->PSO));
+        RHINO_GPU_DEBUG(SetDebugName(m_Context.device, result->PSO, VK_OBJECT_TYPE_PIPELINE, desc.debugName));
+
+        CreateShaderTable(desc, result);
+        return result;
+    }
 
-        for (VkDescriptorSetLayout layout: spaceLayouts) {
-            vkDestroyDescriptorSetLayout(m_Context.device, layout, m_Context.allocator);
+    ComputePSO* VulkanBackend::CompileComputePSO(const ComputePSODesc& desc) noexcept {
+        auto* result = new VulkanComputePSO{};
+        result->context = m_Context;
+        if (CreateComputePipeline(desc, result) != VK_SUCCESS) {
+            result->Release();
+            return nullptr;
         }
         return result;
     }
 
-    RTPSO* VulkanBackend::CreateRTPSO(const RTPSODesc& desc) noexcept {
+    ComputePSO* VulkanBackend::CompileComputePSOAsync(const ComputePSODesc& desc) noexcept {
+        auto* result = new VulkanComputePSO{};
+        result->context = m_Context;
+        result->MarkPending();
+
+        // Desc memory is owned by the caller and may be freed before the task starts.
+        std::vector<uint8_t> bytecode{desc.CS.bytecode, desc.CS.bytecode + desc.CS.bytecodeSize};
+        std::string entrypoint = desc.CS.entrypoint;
+        std::vector<SpecializationConstant> constants{desc.specializationConstants,
+                                                      desc.specializationConstants + desc.specializationConstantsCount};
+        // Caller may release root signature before the task starts, its pipeline layout must outlive the compilation.
+        auto* rootSignature = INTERPRET_AS<VulkanRootSignature*>(desc.rootSignature);
+        rootSignature->AddRef();
+        m_PSOCompilationPool.Enqueue([this, desc, result, rootSignature, bytecode = std::move(bytecode),
+                                      entrypoint = std::move(entrypoint), constants = std::move(constants)]() {
+            ComputePSODesc taskDesc = desc;
+            taskDesc.CS.bytecode = bytecode.data();
+            taskDesc.CS.entrypoint = entrypoint.c_str();
+            taskDesc.specializationConstants = constants.data();
+            const VkResult status = CreateComputePipeline(taskDesc, result);
+            rootSignature->Release();
+            assert(status == VK_SUCCESS && "Failed to compile compute PSO.");
+            if (status != VK_SUCCESS) {
+                result->MarkFailed();
+                return;
+            }
+            result->MarkReady();
+        });
+        return result;
+    }
 
+    void VulkanBackend::CompileComputePSOs(size_t count, const ComputePSODesc* descs, ComputePSO** outPSOs) noexcept {
+        // Batches smaller than this are not worth splitting across worker threads.
+        constexpr size_t MinPSOsPerThread = 32;
+
+        std::vector<VulkanComputePSO*> results(count);
+        std::vector<VkComputePipelineCreateInfo> createInfos(count);
+        std::vector<ComputePipelineSpecialization> specializations(count);
+        std::vector<VkPipeline> pipelines(count, VK_NULL_HANDLE);
+        for (size_t i = 0; i < count; ++i) {
+            results[i] = new VulkanComputePSO{};
+            results[i]->context = m_Context;
+            createInfos[i] = PrepareComputePipeline(descs[i], results[i], &specializations[i]);
+        }
 
-        return nullptr;
-    }
+        const size_t maxChunks = m_PSOCompilationPool.GetThreadsCount() + 1;
+        const size_t chunksCount = std::clamp<size_t>(count / MinPSOsPerThread, 1, maxChunks);
+        const size_t chunkSize = (count + chunksCount - 1) / chunksCount;
+
+        // Chunks are claimed by the calling thread and by pool tasks alike. The calling thread compiles every chunk
+        // no task has started yet, so it never waits for queued tasks. That keeps the call safe from pool threads
+        // and behind long async compilation queues. Tasks started after the last chunk is claimed do nothing,
+        // so they only touch the shared state.
+        struct ChunksState {
+            std::atomic<size_t> nextChunk = 0;
+            std::latch chunksDone;
+            std::function<void(size_t)> compileChunk;
+
+            explicit ChunksState(size_t chunksCount) noexcept : chunksDone(static_cast<ptrdiff_t>(chunksCount)) {}
+
+            void CompileClaimedChunks(size_t chunksCount) noexcept {
+                for (size_t chunk = nextChunk++; chunk < chunksCount; chunk = nextChunk++) {
+                    compileChunk(chunk);
+                    chunksDone.count_down();
+                }
+            }
+        };
 
-    ComputePSO* VulkanBackend::CompileComputePSO(const ComputePSODesc& desc) noexcept {
-        auto* vulkanRootSignature = INTERPRET_AS<VulkanRootSignature*>(desc.rootSignature);
-        auto* result = new VulkanComputePSO{};
-        result->context = m_Context;
+        std::vector<VkResult> chunkResults(chunksCount, VK_SUCCESS);
+        auto state = std::make_shared<ChunksState>(chunksCount);
+        state->compileChunk = [&](size_t chunk) {
+            const size_t first = std::min(chunk * chunkSize, count);
+            const size_t last = std::min(first + chunkSize, count);
+            if (first == last) {
+                return;
+            }
+            chunkResults[chunk] = vkCreateComputePipelines(m_Context.device, m_PipelineCache.GetPipelineCache(),
+                                                           static_cast<uint32_t>(last - first), createInfos.data() + first,
+                                                           m_Context.allocator, pipelines.data() + first);
+        };
 
-        VkShaderModuleCreateInfo shaderModuleInfo{VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO};
-        shaderModuleInfo.codeSize = desc.CS.bytecodeSize;
-        shaderModuleInfo.pCode = reinterpret_cast<const uint32_t*>(desc.CS.bytecode);
-        vkCreateShaderModule(m_Context.device, &shaderModuleInfo, m_Context.allocator, &result->shaderModule);
+        for (size_t chunk = 1; chunk < chunksCount; ++chunk) {
+            m_PSOCompilationPool.Enqueue([state, chunksCount]() { state->CompileClaimedChunks(chunksCount); });
+        }
+        state->CompileClaimedChunks(chunksCount);
+        state->chunksDone.wait();
 
-        VkPipelineShaderStageCreateInfo stageInfo{VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO};
-        stageInfo.flags = 0;
-        stageInfo.module = result->shaderModule;
-        stageInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
-        stageInfo.pName = desc.CS.entrypoint;
-        stageInfo.pSpecializationInfo = nullptr;
+        for (VkResult chunkResult : chunkResults) {
+            assert(chunkResult == VK_SUCCESS && "Failed to compile compute PSOs batch.");
+        }
 
-        VkComputePipelineCreateInfo createInfo{VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO};
-        createInfo.flags = VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT;
-        createInfo.stage = stageInfo;
-        createInfo.layout = vulkanRootSignature->layout;
-        vkCreateComputePipelines(m_Context.device, VK_NULL_HANDLE, 1, &createInfo, m_Context.allocator, &result->PSO);
-        return result;
+        // Pipelines that failed to compile are left VK_NULL_HANDLE by the driver, their PSOs are reported as nullptr.
+        for (size_t i = 0; i < count; ++i) {
+            if (pipelines[i] == VK_NULL_HANDLE) {
+                results[i]->Release();
+                outPSOs[i] = nullptr;
+                continue;
+            }
+            results[i]->PSO = pipelines[i];
+            outPSOs[i] = results[i];
+        }
+    }
+
+    bool VulkanBackend::SavePSOCache() noexcept {
+        return m_PipelineCache.Save();
     }
 
     Buffer* VulkanBackend::CreateBuffer(size_t size, ResourceHeapType heapType, ResourceUsage usage, size_t structuredStride, const char* name) noexcept {
@@ -310,37 +563,22 @@ namespace RHINO::APIVulkan {
     }
 
     Sampler* VulkanBackend::CreateSampler(const SamplerDesc& desc) noexcept {
-        auto* result = new VulkanSampler{};
-        result->context = m_Context;
-
-        Convert::VulkanMinMagMipFilters filters = Convert::ToMTLMinMagMipFilter(desc.textureFilter);
-        VkSamplerCreateInfo samplerInfo{VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO};
-        samplerInfo.flags = 0;
-        samplerInfo.minFilter = filters.min;
-        samplerInfo.magFilter = filters.mag;
-        samplerInfo.mipmapMode = filters.mip;
-        samplerInfo.addressModeU = Convert::ToVkSamplerAddressMode(desc.addresU);
-        samplerInfo.addressModeV = Convert::ToVkSamplerAddressMode(desc.addresV);
-        samplerInfo.addressModeW = Convert::ToVkSamplerAddressMode(desc.addresW);
-        samplerInfo.borderColor = Convert::ToVkBorderColor(desc.borderColor);
-        samplerInfo.compareEnable = desc.comparisonFunc != ComparisonFunction::Never;
-        samplerInfo.compareOp = Convert::ToVkCompareOp(desc.comparisonFunc);
-        samplerInfo.anisotropyEnable = desc.maxAnisotropy > 1;
-        samplerInfo.maxAnisotropy = static_cast<float>(desc.maxAnisotropy);
-        samplerInfo.minLod = desc.minLOD;
-        samplerInfo.maxLod = desc.maxLOD;
-        samplerInfo.mipLodBias = 0;
-        samplerInfo.unnormalizedCoordinates = false;
-        vkCreateSampler(m_Context.device, &samplerInfo, m_Context.allocator, &result->sampler);
-        return result;
+        return m_SamplerCache.AcquireSampler(desc);
     }
 
     DescriptorHeap* VulkanBackend::CreateDescriptorHeap(DescriptorHeapType type, size_t descriptorsCount, const char* name) noexcept {
         auto* result = new VulkanDescriptorHeap{};
-        result->Initialize(name, type, descriptorsCount, m_Context);
+        result->Initialize(name, type, descriptorsCount, m_Context, &m_GarbageCollector);
         return result;
     }
 
+    void VulkanBackend::CopyDescriptors(DescriptorHeap* dstHeap, size_t dstOffset, DescriptorHeap* srcHeap, size_t srcOffset,
+                                        size_t count) noexcept {
+        auto* vulkanDstHeap = INTERPRET_AS<VulkanDescriptorHeap*>(dstHeap);
+        auto* vulkanSrcHeap = INTERPRET_AS<VulkanDescriptorHeap*>(srcHeap);
+        vulkanDstHeap->CopyDescriptors(dstOffset, vulkanSrcHeap, srcOffset, count);
+    }
+
     Swapchain* VulkanBackend::CreateSwapchain(const SwapchainDesc& desc) noexcept {
         auto* result = new VulkanSwapchain{};
         result->Initialize(m_Context, desc, m_DefaultQueueFamIndex);
@@ -349,13 +587,14 @@ namespace RHINO::APIVulkan {
 
     CommandList* VulkanBackend::AllocateCommandList(const char* name) noexcept {
         auto* result = new VulkanCommandList{};
-        result->Initialize(name, m_Context, m_DefaultQueueFamIndex);
+        result->Initialize(name, m_Context, m_DefaultQueueFamIndex, GetASScratchAlignment(), &m_GarbageCollector);
         return result;
     }
 
     void VulkanBackend::SubmitCommandList(CommandList* cmd) noexcept {
         auto* vulkanCMD = INTERPRET_AS<VulkanCommandList*>(cmd);
         vulkanCMD->SubmitToQueue(m_DefaultQueue);
+        m_GarbageCollector.CollectGarbage();
     }
 
     void VulkanBackend::SwapchainPresent(Swapchain* swapchain, Texture2D* toPresent, size_t width, size_t height) noexcept {
@@ -409,6 +648,15 @@ namespace RHINO::APIVulkan {
     bool VulkanBackend::SemaphoreWaitFromHost(const Semaphore* semaphore, uint64_t value, size_t timeout) noexcept {
         const auto* vulkanSemaphore = INTERPRET_AS<const VulkanSemaphore*>(semaphore);
 
+        const bool reached = SpinWait<std::nano>(m_HostWaitSpinTimeInMicroseconds, timeout, UINT64_MAX, [&]() {
+            uint64_t completedValue = 0;
+            vkGetSemaphoreCounterValue(m_Context.device, vulkanSemaphore->semaphore, &completedValue);
+            return completedValue >= value;
+        });
+        if (reached) {
+            return true;
+        }
+
         VkSemaphoreWaitInfo waitInfo{VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO};
         waitInfo.flags = 0;
         waitInfo.semaphoreCount = 1;
@@ -419,6 +667,42 @@ namespace RHINO::APIVulkan {
         return status == VK_SUCCESS;
     }
 
+    bool VulkanBackend::SemaphoresWaitFromHost(size_t count, const SemaphoreWaitDesc* waits, bool waitAll, size_t timeout) noexcept {
+        std::vector<VkSemaphore> semaphores(count);
+        std::vector<uint64_t> values(count);
+        for (size_t i = 0; i < count; ++i) {
+            semaphores[i] = INTERPRET_AS<const VulkanSemaphore*>(waits[i].semaphore)->semaphore;
+            values[i] = waits[i].value;
+        }
+
+        const bool reached = SpinWait<std::nano>(m_HostWaitSpinTimeInMicroseconds, timeout, UINT64_MAX, [&]() {
+            size_t reachedCount = 0;
+            for (size_t i = 0; i < count; ++i) {
+                uint64_t completedValue = 0;
+                vkGetSemaphoreCounterValue(m_Context.device, semaphores[i], &completedValue);
+                reachedCount += completedValue >= values[i] ? 1 : 0;
+            }
+            return waitAll ? reachedCount == count : reachedCount > 0;
+        });
+        if (reached) {
+            return true;
+        }
+
+        VkSemaphoreWaitInfo waitInfo{VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO};
+        waitInfo.flags = waitAll ? 0 : VK_SEMAPHORE_WAIT_ANY_BIT;
+        waitInfo.semaphoreCount = static_cast<uint32_t>(count);
+        waitInfo.pSemaphores = semaphores.data();
+        waitInfo.pValues = values.data();
+
+        const VkResult status = vkWaitSemaphores(m_Context.device, &waitInfo, timeout);
+        return status == VK_SUCCESS;
+    }
+
+    void VulkanBackend::OnSemaphoreValue(const Semaphore* semaphore, uint64_t value, SemaphoreCallback callback, void* userData) noexcept {
+        const auto* vulkanSemaphore = INTERPRET_AS<const VulkanSemaphore*>(semaphore);
+        m_SemaphoreWaiter.AddCallback(vulkanSemaphore->semaphore, value, callback, userData);
+    }
+
     void VulkanBackend::SemaphoreWaitFromQueue(const Semaphore* semaphore, uint64_t value) noexcept {
         const auto* vulkanSemaphore = INTERPRET_AS<const VulkanSemaphore*>(semaphore);
 
@@ -443,6 +727,141 @@ namespace RHINO::APIVulkan {
         return result;
     }
 
+    VkComputePipelineCreateInfo VulkanBackend::PrepareComputePipeline(const ComputePSODesc& desc, VulkanComputePSO* result,
+                                                                      ComputePipelineSpecialization* specialization) noexcept {
+        auto* vulkanRootSignature = INTERPRET_AS<VulkanRootSignature*>(desc.rootSignature);
+
+        result->shaderModule = m_ShaderModuleCache.AcquireShaderModule(desc.CS.bytecode, desc.CS.bytecodeSize);
+
+        VkPipelineShaderStageCreateInfo stageInfo{VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO};
+        stageInfo.flags = 0;
+        stageInfo.module = result->shaderModule->shaderModule;
+        stageInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+        stageInfo.pName = desc.CS.entrypoint;
+        stageInfo.pSpecializationInfo = nullptr;
+
+        if (desc.specializationConstantsCount) {
+            // Values are read in place from desc constants array.
+            specialization->entries.resize(desc.specializationConstantsCount);
+            for (size_t i = 0; i < desc.specializationConstantsCount; ++i) {
+                VkSpecializationMapEntry& entry = specialization->entries[i];
+                entry.constantID = desc.specializationConstants[i].constantID;
+                entry.offset = static_cast<uint32_t>(i * sizeof(SpecializationConstant) + offsetof(SpecializationConstant, value));
+                entry.size = sizeof(uint32_t);
+            }
+            specialization->info.mapEntryCount = static_cast<uint32_t>(specialization->entries.size());
+            specialization->info.pMapEntries = specialization->entries.data();
+            specialization->info.dataSize = desc.specializationConstantsCount * sizeof(SpecializationConstant);
+            specialization->info.pData = desc.specializationConstants;
+            stageInfo.pSpecializationInfo = &specialization->info;
+        }
+
+        VkComputePipelineCreateInfo createInfo{VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO};
+        createInfo.flags = VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT;
+        createInfo.stage = stageInfo;
+        createInfo.layout = vulkanRootSignature->layout;
+        if (desc.splitDispatches) {
+            createInfo.flags |= VK_PIPELINE_CREATE_DISPATCH_BASE_BIT;
+            result->splitDispatches = true;
+        }
+        result->SetWorkgroupSize(desc.workgroupSize);
+        if (m_CapturePSOStatistics) {
+            createInfo.flags |= VK_PIPELINE_CREATE_CAPTURE_STATISTICS_BIT_KHR;
+            result->statisticsCaptured = true;
+        }
+        return createInfo;
+    }
+
+    VkResult VulkanBackend::CreateComputePipeline(const ComputePSODesc& desc, VulkanComputePSO* result) noexcept {
+        ComputePipelineSpecialization specialization{};
+        const VkComputePipelineCreateInfo createInfo = PrepareComputePipeline(desc, result, &specialization);
+        return vkCreateComputePipelines(m_Context.device, m_PipelineCache.GetPipelineCache(), 1, &createInfo, m_Context.allocator,
+                                        &result->PSO);
+    }
+
+    void VulkanBackend::CreateShaderTable(const RTPSODesc& desc, VulkanRTPSO* result) noexcept {
+        const VkDeviceSize handleSize = m_RayTracingProps.shaderGroupHandleSize;
+        const VkDeviceSize handleAlignment = m_RayTracingProps.shaderGroupHandleAlignment;
+        const VkDeviceSize baseAlignment = m_RayTracingProps.shaderGroupBaseAlignment;
+        const VkDeviceSize recordStride = RHINO_CEIL_TO_MULTIPLE_OF(handleSize, handleAlignment);
+        result->tableRecordStride = recordStride;
+        result->tableBaseAlignment = baseAlignment;
+
+        // Raygen record is a separate region, so each one starts at base alignment.
+        // Miss and hit group regions are base aligned and their records are packed by stride.
+        VkDeviceSize tableSize = 0;
+        result->recordOffsets.resize(desc.recordsCount);
+        for (size_t i = 0; i < desc.recordsCount; ++i) {
+            if (desc.records[i].recordType == RTShaderTableRecordType::RayGeneration) {
+                result->recordOffsets[i] = tableSize;
+                tableSize = RHINO_CEIL_TO_MULTIPLE_OF(tableSize + recordStride, baseAlignment);
+            }
+        }
+        result->missTableBegin = tableSize;
+        for (size_t i = 0; i < desc.recordsCount; ++i) {
+            if (desc.records[i].recordType == RTShaderTableRecordType::Miss) {
+                result->recordOffsets[i] = tableSize;
+                tableSize += recordStride;
+            }
+        }
+        result->missTableEnd = tableSize;
+        tableSize = RHINO_CEIL_TO_MULTIPLE_OF(tableSize, baseAlignment);
+        result->hitGroupTableBegin = tableSize;
+        for (size_t i = 0; i < desc.recordsCount; ++i) {
+            if (desc.records[i].recordType == RTShaderTableRecordType::HitGroup) {
+                result->recordOffsets[i] = tableSize;
+                tableSize += recordStride;
+            }
+        }
+        result->hitGroupTableEnd = tableSize;
+
+        std::vector<uint8_t> handles(desc.recordsCount * handleSize);
+        RHINO_VKS(EXT::vkGetRayTracingShaderGroupHandlesKHR(m_Context.device, result->PSO, 0, static_cast<uint32_t>(desc.recordsCount),
+                                                            handles.size(), handles.data()));
+        result->shaderTableData.resize(tableSize);
+        for (size_t i = 0; i < desc.recordsCount; ++i) {
+            memcpy(result->shaderTableData.data() + result->recordOffsets[i], handles.data() + i * handleSize, handleSize);
+        }
+
+        VkBufferCreateInfo createInfo{VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+        createInfo.usage = VK_BUFFER_USAGE_SHADER_BINDING_TABLE_BIT_KHR | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT |
+                           VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        createInfo.size = std::max<VkDeviceSize>(tableSize, baseAlignment);
+        createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        RHINO_VKS(vkCreateBuffer(m_Context.device, &createInfo, m_Context.allocator, &result->shaderTable));
+
+        VkMemoryRequirements memReqs;
+        vkGetBufferMemoryRequirements(m_Context.device, result->shaderTable, &memReqs);
+
+        VkMemoryAllocateFlagsInfo allocateFlagsInfo{VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO};
+        allocateFlagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
+
+        VkMemoryAllocateInfo alloc{VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO};
+        alloc.pNext = &allocateFlagsInfo;
+        alloc.allocationSize = memReqs.size;
+        alloc.memoryTypeIndex = SelectMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_Context);
+        RHINO_VKS(vkAllocateMemory(m_Context.device, &alloc, m_Context.allocator, &result->shaderTableMemory));
+        vkBindBufferMemory(m_Context.device, result->shaderTable, result->shaderTableMemory, 0);
+
+        VkBufferDeviceAddressInfo addressInfo{VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO};
+        addressInfo.buffer = result->shaderTable;
+        result->shaderTableAddress = vkGetBufferDeviceAddress(m_Context.device, &addressInfo);
+    }
+
+    VkDeviceSize VulkanBackend::GetASScratchAlignment() const noexcept {
+        // Zero when ray tracing is not supported.
+        return std::max<VkDeviceSize>(m_ASProps.minAccelerationStructureScratchOffsetAlignment, 1);
+    }
+
+    bool VulkanBackend::IsDeviceExtensionSupported(const char* extensionName) noexcept {
+        uint32_t extensionsCount = 0;
+        RHINO_VKS(vkEnumerateDeviceExtensionProperties(m_Context.physicalDevice, nullptr, &extensionsCount, nullptr));
+        std::vector<VkExtensionProperties> extensions(extensionsCount);
+        RHINO_VKS(vkEnumerateDeviceExtensionProperties(m_Context.physicalDevice, nullptr, &extensionsCount, extensions.data()));
+        return std::any_of(extensions.begin(), extensions.end(),
+                           [&](const VkExtensionProperties& ext) { return strcmp(ext.extensionName, extensionName) == 0; });
+    }
+
     void VulkanBackend::SelectQueues(VkDeviceQueueCreateInfo queueInfos[3], uint32_t* infosCount) noexcept {
         uint32_t queuesCount = 0;
         vkGetPhysicalDeviceQueueFamilyProperties(m_Context.physicalDevice, &queuesCount, nullptr);
@@ -556,43 +975,76 @@ namespace RHINO::APIVulkan {
     }
 
     ASPrebuildInfo VulkanBackend::GetBLASPrebuildInfo(const BLASDesc& desc) noexcept {
-        VkDeviceOrHostAddressConstKHR constDummyAddr{VkDeviceAddress{NULL}};
-        VkDeviceOrHostAddressKHR dummyAddr{VkDeviceAddress{NULL}};
-
-        VkAccelerationStructureGeometryKHR asGeom{VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR};
-        asGeom.flags = VK_GEOMETRY_OPAQUE_BIT_KHR;
-        asGeom.geometryType = VK_GEOMETRY_TYPE_TRIANGLES_KHR;
-        asGeom.geometry.triangles.indexType = Convert::ToVkIndexType(desc.indexFormat);
-        asGeom.geometry.triangles.indexData = constDummyAddr;
-        asGeom.geometry.triangles.vertexStride = desc.vertexStride;
-        asGeom.geometry.triangles.vertexFormat = Convert::ToVkFormat(desc.vertexFormat);
-        asGeom.geometry.triangles.vertexData = constDummyAddr;
-        asGeom.geometry.triangles.maxVertex = desc.vertexCount;
-        asGeom.geometry.triangles.transformData = constDummyAddr;
-
-        VkAccelerationStructureBuildGeometryInfoKHR buildInfo{};
-        buildInfo.dstAccelerationStructure = VK_NULL_HANDLE;
-        buildInfo.flags = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR |
-                          VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR;
-        buildInfo.mode = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
-        buildInfo.type = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
-        buildInfo.geometryCount = 1;
-        buildInfo.pGeometries = &asGeom;
-        buildInfo.ppGeometries = nullptr;
-        buildInfo.scratchData = dummyAddr;
-
-        VkAccelerationStructureBuildSizesInfoKHR outSizesInfo{VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR};
-
-        EXT::vkGetAccelerationStructureBuildSizesKHR(m_Context.device, VK_ACCELERATION_STRUCTURE_BUILD_TYPE_DEVICE_KHR, &buildInfo, nullptr,
-                                                &outSizesInfo);
+        const VkAccelerationStructureBuildSizesInfoKHR sizes = GetBLASBuildSizes(desc, m_Context);
+        ASPrebuildInfo result{};
+        result.scratchBufferSizeInBytes = sizes.buildScratchSize;
+        result.MaxASSizeInBytes = sizes.accelerationStructureSize;
+        return result;
+    }
+
+    ASPrebuildInfo VulkanBackend::GetBLASesPrebuildInfo(size_t count, const BLASDesc* descs) noexcept {
+        // Matches VulkanCommandList::BuildBLASes layout: every scratch region and AS storage region starts aligned.
+        const VkDeviceSize scratchAlignment = GetASScratchAlignment();
         ASPrebuildInfo result{};
-        result.scratchBufferSizeInBytes = outSizesInfo.buildScratchSize;
-        result.MaxASSizeInBytes = outSizesInfo.accelerationStructureSize;
+        for (size_t i = 0; i < count; ++i) {
+            const VkAccelerationStructureBuildSizesInfoKHR sizes = GetBLASBuildSizes(descs[i], m_Context);
+            result.scratchBufferSizeInBytes += RHINO_CEIL_TO_MULTIPLE_OF(sizes.buildScratchSize, scratchAlignment);
+            result.MaxASSizeInBytes += RHINO_CEIL_TO_MULTIPLE_OF(sizes.accelerationStructureSize, ASStorageOffsetAlignment);
+        }
+        return result;
+    }
+
+    bool VulkanBackend::GetBLASCompactedSize(BLAS* blas, size_t* outSizeInBytes) noexcept {
+        auto* vulkanBLAS = INTERPRET_AS<VulkanBLAS*>(blas);
+        VkDeviceSize compactedSize = 0;
+        if (!vulkanBLAS->compactedSizeQuery.GetResult(&compactedSize)) {
+            return false;
+        }
+        *outSizeInBytes = compactedSize;
+        return true;
+    }
+
+    bool VulkanBackend::GetBLASSerializedSize(BLAS* blas, size_t* outSizeInBytes) noexcept {
+        auto* vulkanBLAS = INTERPRET_AS<VulkanBLAS*>(blas);
+        VkDeviceSize serializedSize = 0;
+        if (!vulkanBLAS->serializedSizeQuery.GetResult(&serializedSize)) {
+            return false;
+        }
+        *outSizeInBytes = serializedSize;
+        return true;
+    }
+
+    SerializedASInfo VulkanBackend::GetSerializedBLASInfo(const void* data, size_t sizeInBytes) noexcept {
+        // Blob starts with driver UUID and compatibility UUID, followed by serialized size, deserialized size and handles count.
+        constexpr size_t versionSize = 2 * VK_UUID_SIZE;
+        constexpr size_t headerSize = versionSize + 3 * sizeof(uint64_t);
+        SerializedASInfo result{};
+        // Compatibility query is an extension function, it is not loaded without acceleration structures support.
+        if (!m_Context.accelerationStructures || sizeInBytes < headerSize) {
+            return result;
+        }
+
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        VkAccelerationStructureVersionInfoKHR versionInfo{VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_VERSION_INFO_KHR};
+        versionInfo.pVersionData = bytes;
+        VkAccelerationStructureCompatibilityKHR compatibility = VK_ACCELERATION_STRUCTURE_COMPATIBILITY_INCOMPATIBLE_KHR;
+        EXT::vkGetDeviceAccelerationStructureCompatibilityKHR(m_Context.device, &versionInfo, &compatibility);
+
+        uint64_t sizes[2] = {};
+        memcpy(sizes, bytes + versionSize, sizeof(sizes));
+        result.serializedSizeInBytes = sizes[0];
+        result.deserializedSizeInBytes = sizes[1];
+        result.compatible = compatibility == VK_ACCELERATION_STRUCTURE_COMPATIBILITY_COMPATIBLE_KHR && sizes[0] >= headerSize &&
+                            sizes[0] <= sizeInBytes;
         return result;
     }
 
     ASPrebuildInfo VulkanBackend::GetTLASPrebuildInfo(const TLASDesc& desc) noexcept {
+        const VkAccelerationStructureBuildSizesInfoKHR sizes = GetTLASBuildSizes(desc, m_Context);
         ASPrebuildInfo result{};
+        result.scratchBufferSizeInBytes = sizes.buildScratchSize;
+        result.MaxASSizeInBytes = sizes.accelerationStructureSize;
+        result.updateScratchBufferSizeInBytes = desc.allowUpdate ? sizes.updateScratchSize : 0;
         return result;
     }
 } // namespace RHINO::APIVulkan
@@ -4,6 +4,13 @@
 
 #include "RHINOInterfaceImplBase.h"
 #include "VulkanBackendTypes.h"
+#include "VulkanGarbageCollector.h"
+#include "VulkanSemaphoreWaiter.h"
+#include "VulkanSamplerCache.h"
+#include "VulkanRootSignatureCache.h"
+#include "VulkanPipelineCache.h"
+#include "VulkanShaderModuleCache.h"
+#include "Utils/ThreadPool.h"
 
 namespace RHINO::APIVulkan {
     class VulkanDescriptorHeap;
@@ -14,13 +21,16 @@ namespace RHINO::APIVulkan {
         explicit VulkanBackend() noexcept = default;
 
     public:
-        void Initialize() noexcept final;
+        void Initialize(const InitializeDesc& desc) noexcept final;
         void Release() noexcept final;
 
     public:
         RootSignature* SerializeRootSignature(const RootSignatureDesc& desc) noexcept final;
         RTPSO* CreateRTPSO(const RTPSODesc& desc) noexcept final;
         ComputePSO* CompileComputePSO(const ComputePSODesc& desc) noexcept final;
+        ComputePSO* CompileComputePSOAsync(const ComputePSODesc& desc) noexcept final;
+        void CompileComputePSOs(size_t count, const ComputePSODesc* descs, ComputePSO** outPSOs) noexcept final;
+        bool SavePSOCache() noexcept final;
 
         Buffer* CreateBuffer(size_t size, ResourceHeapType heapType, ResourceUsage usage, size_t structuredStride, const char* name) noexcept final;
         void* MapMemory(Buffer* buffer, size_t offset, size_t size) noexcept final;
@@ -29,11 +39,17 @@ namespace RHINO::APIVulkan {
                            const char* name) noexcept final;
         Sampler* CreateSampler(const SamplerDesc& desc) noexcept final;
         DescriptorHeap* CreateDescriptorHeap(DescriptorHeapType type, size_t descriptorsCount, const char* name) noexcept final;
+        void CopyDescriptors(DescriptorHeap* dstHeap, size_t dstOffset, DescriptorHeap* srcHeap, size_t srcOffset,
+                             size_t count) noexcept final;
         Swapchain* CreateSwapchain(const SwapchainDesc& desc) noexcept final;
 
         CommandList* AllocateCommandList(const char* name) noexcept final;
 
         ASPrebuildInfo GetBLASPrebuildInfo(const BLASDesc& desc) noexcept final;
+        ASPrebuildInfo GetBLASesPrebuildInfo(size_t count, const BLASDesc* descs) noexcept final;
+        bool GetBLASCompactedSize(BLAS* blas, size_t* outSizeInBytes) noexcept final;
+        bool GetBLASSerializedSize(BLAS* blas, size_t* outSizeInBytes) noexcept final;
+        SerializedASInfo GetSerializedBLASInfo(const void* data, size_t sizeInBytes) noexcept final;
         ASPrebuildInfo GetTLASPrebuildInfo(const TLASDesc& desc) noexcept final;
 
     public:
@@ -46,10 +62,25 @@ namespace RHINO::APIVulkan {
         void SignalFromQueue(Semaphore* semaphore, uint64_t value) noexcept final;
         void SignalFromHost(Semaphore* semaphore, uint64_t value) noexcept final;
         bool SemaphoreWaitFromHost(const Semaphore* semaphore, uint64_t value, size_t timeout) noexcept final;
+        bool SemaphoresWaitFromHost(size_t count, const SemaphoreWaitDesc* waits, bool waitAll, size_t timeout) noexcept final;
+        void OnSemaphoreValue(const Semaphore* semaphore, uint64_t value, SemaphoreCallback callback, void* userData) noexcept final;
         void SemaphoreWaitFromQueue(const Semaphore* semaphore, uint64_t value) noexcept final;
         uint64_t GetSemaphoreCompletedValue(const Semaphore* semaphore) noexcept final;
 
     private:
+        // Specialization info storage. Has to outlive pipeline creation.
+        struct ComputePipelineSpecialization {
+            VkSpecializationInfo info = {};
+            std::vector<VkSpecializationMapEntry> entries = {};
+        };
+
+    private:
+        VkComputePipelineCreateInfo PrepareComputePipeline(const ComputePSODesc& desc, VulkanComputePSO* result,
+                                                           ComputePipelineSpecialization* specialization) noexcept;
+        VkResult CreateComputePipeline(const ComputePSODesc& desc, VulkanComputePSO* result) noexcept;
+        void CreateShaderTable(const RTPSODesc& desc, VulkanRTPSO* result) noexcept;
+        VkDeviceSize GetASScratchAlignment() const noexcept;
+        bool IsDeviceExtensionSupported(const char* extensionName) noexcept;
         void SelectQueues(VkDeviceQueueCreateInfo queueInfos[3], uint32_t* infosCount) noexcept;
     private:
         VulkanObjectContext m_Context = {};
@@ -60,6 +91,21 @@ namespace RHINO::APIVulkan {
         uint32_t m_AsyncComputeQueueFamIndex = 0;
         VkQueue m_CopyQueue = VK_NULL_HANDLE;
         uint32_t m_CopyQueueFamIndex = 0;
+
+        bool m_CapturePSOStatistics = false;
+        size_t m_HostWaitSpinTimeInMicroseconds = 0;
+        bool m_RayTracingSupported = false;
+        bool m_RayQuerySupported = false;
+        VkPhysicalDeviceRayTracingPipelinePropertiesKHR m_RayTracingProps = {};
+        VkPhysicalDeviceAccelerationStructurePropertiesKHR m_ASProps = {};
+
+        VulkanGarbageCollector m_GarbageCollector = {};
+        VulkanSemaphoreWaiter m_SemaphoreWaiter = {};
+        VulkanSamplerCache m_SamplerCache = {};
+        VulkanRootSignatureCache m_RootSignatureCache = {};
+        VulkanPipelineCache m_PipelineCache = {};
+        VulkanShaderModuleCache m_ShaderModuleCache = {};
+        ThreadPool m_PSOCompilationPool = {};
     };
 }// namespace RHINO::APIVulkan
 
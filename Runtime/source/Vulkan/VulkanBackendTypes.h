@@ -6,12 +6,17 @@
 
 namespace RHINO::APIVulkan {
     class VulkanDescriptorHeap;
+    class VulkanSamplerCache;
+    class VulkanRootSignatureCache;
+    class VulkanShaderModuleCache;
 
     struct VulkanObjectContext {
         VkInstance instance = VK_NULL_HANDLE;
         VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
         VkDevice device = VK_NULL_HANDLE;
         VkAllocationCallbacks* allocator = nullptr;
+        // Device has acceleration structures enabled. Descriptor heaps hold TLAS descriptors only in this case.
+        bool accelerationStructures = false;
     };
 
     class VulkanBuffer : public BufferBase {
@@ -64,13 +69,18 @@ namespace RHINO::APIVulkan {
     class VulkanSampler : public SamplerBase {
     public:
         VkSampler sampler = VK_NULL_HANDLE;
+        // Sampler descriptor data. Written to sampler heaps as is.
+        std::vector<uint8_t> descriptor{};
         VulkanObjectContext context = {};
 
+        SamplerDesc desc = {};
+        size_t descHash = 0;
+        uint32_t refCount = 0;
+        VulkanSamplerCache* cache = nullptr;
+
     public:
-        void Release() noexcept final {
-            vkDestroySampler(this->context.device, this->sampler, this->context.allocator);
-            delete this;
-        }
+        // Defined in VulkanSamplerCache.cpp
+        void Release() noexcept final;
     };
 
     class VulkanRootSignature : public RootSignature {
@@ -79,61 +89,238 @@ namespace RHINO::APIVulkan {
         std::map<size_t, std::pair<DescriptorHeapType, size_t>> heapOffsetsInDescriptorsBySpace{};
         VulkanObjectContext context = {};
 
+        std::vector<size_t> cacheKey{};
+        uint32_t refCount = 0;
+        VulkanRootSignatureCache* cache = nullptr;
+
     public:
-        void Release() noexcept final {
-            vkDestroyPipelineLayout(this->context.device, this->layout, this->context.allocator);
-            delete this;
-        }
+        // Defined in VulkanRootSignatureCache.cpp
+        void AddRef() noexcept;
+        void Release() noexcept final;
+    };
+
+    /**
+     * Shader module shared between PSOs with identical bytecode.
+     */
+    class VulkanShaderModule {
+    public:
+        VkShaderModule shaderModule = VK_NULL_HANDLE;
+        std::vector<uint8_t> bytecode{};
+        size_t bytecodeHash = 0;
+        uint32_t refCount = 0;
+        VulkanShaderModuleCache* cache = nullptr;
+
+    public:
+        // Defined in VulkanShaderModuleCache.cpp
+        void Release() noexcept;
     };
 
     class VulkanRTPSO : public RTPSO {
     public:
+        VkPipeline PSO = VK_NULL_HANDLE;
+        std::vector<VulkanShaderModule*> shaderModules{};
+
+        // Device local shader binding table. Raygen records start at base alignment each,
+        // miss and hit group records are packed by handle alignment into base aligned regions.
+        VkBuffer shaderTable = VK_NULL_HANDLE;
+        VkDeviceMemory shaderTableMemory = VK_NULL_HANDLE;
+        VkDeviceAddress shaderTableAddress = 0;
+        // Table contents with shader group handles. Uploaded by CommandList::BuildRTPSO.
+        std::vector<uint8_t> shaderTableData{};
+        // Byte offset of each RTPSODesc record in shader table.
+        std::vector<VkDeviceSize> recordOffsets{};
+        VkDeviceSize tableRecordStride = 0;
+        VkDeviceSize tableBaseAlignment = 0;
+        VkDeviceSize missTableBegin = 0;
+        VkDeviceSize missTableEnd = 0;
+        VkDeviceSize hitGroupTableBegin = 0;
+        VkDeviceSize hitGroupTableEnd = 0;
         VulkanObjectContext context = {};
 
     public:
         void Release() noexcept final {
-            //TODO: implement
+            vkDestroyPipeline(this->context.device, this->PSO, this->context.allocator);
+            vkDestroyBuffer(this->context.device, this->shaderTable, this->context.allocator);
+            vkFreeMemory(this->context.device, this->shaderTableMemory, this->context.allocator);
+            for (VulkanShaderModule* shaderModule : this->shaderModules) {
+                shaderModule->Release();
+            }
+            delete this;
         }
     };
 
-    class VulkanComputePSO : public ComputePSO {
+    class VulkanComputePSO : public ComputePSOBase {
     public:
         VkPipeline PSO = VK_NULL_HANDLE;
-        VkShaderModule shaderModule = VK_NULL_HANDLE;
+        VulkanShaderModule* shaderModule = nullptr;
+        bool statisticsCaptured = false;
+        // Created with VK_PIPELINE_CREATE_DISPATCH_BASE_BIT.
+        bool splitDispatches = false;
         VulkanObjectContext context = {};
 
     public:
+        // Defined in VulkanBackend.cpp
+        bool GetStatistics(PSOStatistics* outStatistics) noexcept final;
         void Release() noexcept final {
+            Wait();
             vkDestroyPipeline(this->context.device, this->PSO, this->context.allocator);
-            vkDestroyShaderModule(this->context.device, this->shaderModule, this->context.allocator);
+            if (this->shaderModule) {
+                this->shaderModule->Release();
+            }
             delete this;
         }
     };
 
+    /**
+     * Buffer with its own memory block shared by acceleration structures built in one batch.
+     * Released when the last acceleration structure placed in it is released.
+     */
+    class VulkanASStorage {
+    public:
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        std::atomic<uint32_t> refCount = 0;
+        VulkanObjectContext context = {};
+
+    public:
+        void Release() noexcept {
+            if (--this->refCount == 0) {
+                vkDestroyBuffer(this->context.device, this->buffer, this->context.allocator);
+                vkFreeMemory(this->context.device, this->memory, this->context.allocator);
+                delete this;
+            }
+        }
+    };
+
+    /**
+     * Query pool with compacted or serialized sizes of BLASes queried together. Released with the last of them.
+     */
+    class VulkanASSizeQueryPool {
+    public:
+        VkQueryPool queryPool = VK_NULL_HANDLE;
+        std::atomic<uint32_t> refCount = 0;
+        VulkanObjectContext context = {};
+
+    public:
+        void Release() noexcept {
+            if (--this->refCount == 0) {
+                vkDestroyQueryPool(this->context.device, this->queryPool, this->context.allocator);
+                delete this;
+            }
+        }
+    };
+
+    /**
+     * Slot of one BLAS in shared size query pool.
+     */
+    struct VulkanASSizeQuery {
+        VulkanASSizeQueryPool* pool = nullptr;
+        uint32_t index = 0;
+
+        // Returns false while size is not requested or not yet written by GPU.
+        bool GetResult(VkDeviceSize* outSize) const noexcept {
+            if (!this->pool) {
+                return false;
+            }
+            uint64_t size = 0;
+            const VkResult status = vkGetQueryPoolResults(this->pool->context.device, this->pool->queryPool, this->index, 1, sizeof(size),
+                                                          &size, sizeof(size), VK_QUERY_RESULT_64_BIT);
+            if (status != VK_SUCCESS) {
+                return false;
+            }
+            *outSize = size;
+            return true;
+        }
+
+        void Reset(VulkanASSizeQueryPool* newPool, uint32_t newIndex) noexcept {
+            Release();
+            this->pool = newPool;
+            this->index = newIndex;
+        }
+
+        void Release() noexcept {
+            if (this->pool) {
+                this->pool->Release();
+                this->pool = nullptr;
+            }
+        }
+    };
+
     class VulkanBLAS : public BLASBase {
     public:
         VkAccelerationStructureKHR accelerationStructure = VK_NULL_HANDLE;
-        VkBuffer buffer = VK_NULL_HANDLE;
+        VkDeviceAddress deviceAddress = 0;
+        VulkanASStorage* storage = nullptr;
+        VkDeviceSize storageOffset = 0;
+        VkDeviceSize size = 0;
+        VulkanASSizeQuery compactedSizeQuery{};
+        VulkanASSizeQuery serializedSizeQuery{};
         VulkanObjectContext context = {};
 
     public:
         void Release() noexcept final {
             EXT::vkDestroyAccelerationStructureKHR(this->context.device, this->accelerationStructure, this->context.allocator);
-            vkDestroyBuffer(this->context.device, this->buffer, this->context.allocator);
+            this->storage->Release();
+            this->compactedSizeQuery.Release();
+            this->serializedSizeQuery.Release();
             delete this;
         }
     };
 
+    /**
+     * Host visible TLAS instance buffer read by builds directly. Mapped for its whole lifetime.
+     * Owned by TLAS and referenced by command lists recording builds that read it until they are executed.
+     */
+    class VulkanTLASInstanceBuffer : public Object {
+    public:
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkAccelerationStructureInstanceKHR* mapped = nullptr;
+        VkDeviceAddress deviceAddress = 0;
+        // Host copy of written instances, so writes skip unchanged ones.
+        std::vector<VkAccelerationStructureInstanceKHR> instances{};
+        std::atomic<uint32_t> refCount = 0;
+        VulkanObjectContext context = {};
+
+    public:
+        void AddRef() noexcept {
+            ++this->refCount;
+        }
+
+        // Only TLAS holds the buffer, no recorded or executing build reads it.
+        bool IsIdle() const noexcept {
+            return this->refCount.load(std::memory_order_acquire) == 1;
+        }
+
+        void Release() noexcept final {
+            if (--this->refCount == 0) {
+                vkUnmapMemory(this->context.device, this->memory);
+                vkDestroyBuffer(this->context.device, this->buffer, this->context.allocator);
+                vkFreeMemory(this->context.device, this->memory, this->context.allocator);
+                delete this;
+            }
+        }
+    };
+
     class VulkanTLAS : public TLASBase {
     public:
         VkAccelerationStructureKHR accelerationStructure = VK_NULL_HANDLE;
-        VkBuffer buffer;
+        VkDeviceAddress deviceAddress = 0;
+        VulkanASStorage* storage = nullptr;
+        bool allowUpdate = false;
+        size_t instancesCount = 0;
+
+        // Builds and updates write instances to an idle buffer of the ring, ring grows while all of them are in use.
+        std::vector<VulkanTLASInstanceBuffer*> instanceBuffers{};
         VulkanObjectContext context = {};
 
     public:
         void Release() noexcept final {
             EXT::vkDestroyAccelerationStructureKHR(this->context.device, this->accelerationStructure, this->context.allocator);
-            vkDestroyBuffer(this->context.device, this->buffer, this->context.allocator);
+            this->storage->Release();
+            for (VulkanTLASInstanceBuffer* instanceBuffer : this->instanceBuffers) {
+                instanceBuffer->Release();
+            }
             delete this;
         }
     };
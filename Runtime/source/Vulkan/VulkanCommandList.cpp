@@ -5,10 +5,14 @@
 #include "VulkanConverters.h"
 #include "VulkanDescriptorHeap.h"
 #include "VulkanUtils.h"
+#include "Utils/ASInstancePacking.h"
 
 namespace RHINO::APIVulkan {
-    void VulkanCommandList::Initialize(const char* name, VulkanObjectContext context, uint32_t queueFamilyIdx) noexcept {
+    void VulkanCommandList::Initialize(const char* name, VulkanObjectContext context, uint32_t queueFamilyIdx,
+                                       VkDeviceSize asScratchAlignment, VulkanGarbageCollector* garbageCollector) noexcept {
         m_Context = context;
+        m_ASScratchAlignment = asScratchAlignment;
+        m_GarbageCollector = garbageCollector;
 
         VkCommandPoolCreateInfo poolCreateInfo{VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
         poolCreateInfo.queueFamilyIndex = queueFamilyIdx;
@@ -19,6 +23,7 @@ namespace RHINO::APIVulkan {
         props.pNext = &descriptorProps;
         vkGetPhysicalDeviceProperties2(m_Context.physicalDevice, &props);
         m_DescriptorProps = descriptorProps;
+        memcpy(m_MaxWorkgroupCount, props.properties.limits.maxComputeWorkGroupCount, sizeof(m_MaxWorkgroupCount));
 
         VkCommandBufferAllocateInfo cmdAlloc{VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
         cmdAlloc.commandPool = m_Pool;
@@ -26,6 +31,26 @@ namespace RHINO::APIVulkan {
         cmdAlloc.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
         vkAllocateCommandBuffers(m_Context.device, &cmdAlloc, &m_Cmd);
 
+        BeginRecording();
+    }
+
+    void VulkanCommandList::Reset() noexcept {
+        // Not submitted since last reset, nothing on GPU references them.
+        for (Object* object : m_RetiredObjects) {
+            object->Release();
+        }
+        m_RetiredObjects.clear();
+        // Ownership of compaction sources is passed on submission only.
+        m_CompactedSources.clear();
+        m_RootSignature = nullptr;
+        m_ComputePSO = nullptr;
+        m_BoundCBVSRVUAVHeapType = DescriptorHeapType::Count;
+
+        vkResetCommandPool(m_Context.device, m_Pool, 0);
+        BeginRecording();
+    }
+
+    void VulkanCommandList::BeginRecording() noexcept {
         VkCommandBufferBeginInfo beginInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
         beginInfo.flags = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
         beginInfo.pInheritanceInfo = nullptr;
@@ -33,6 +58,10 @@ namespace RHINO::APIVulkan {
     }
 
     void VulkanCommandList::Release() noexcept {
+        // Not submitted, nothing on GPU references them.
+        for (Object* object : m_RetiredObjects) {
+            object->Release();
+        }
         vkFreeCommandBuffers(m_Context.device, m_Pool, 1, &m_Cmd);
         vkDestroyCommandPool(m_Context.device, m_Pool, m_Context.allocator);
         // Command pool is managed by VulkanBackend instance and should be released by it.
@@ -42,14 +71,14 @@ namespace RHINO::APIVulkan {
     void VulkanCommandList::SubmitToQueue(VkQueue queue) noexcept {
         vkEndCommandBuffer(m_Cmd);
 
-        VkSubmitInfo submitInfo{VK_STRUCTURE_TYPE_SUBMIT_INFO};
-        submitInfo.commandBufferCount = 1;
-        submitInfo.pCommandBuffers = &m_Cmd;
-        vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE);
+        m_RetiredObjects.insert(m_RetiredObjects.end(), m_CompactedSources.begin(), m_CompactedSources.end());
+        m_CompactedSources.clear();
+        m_GarbageCollector->Submit(queue, m_Cmd, m_RetiredObjects);
     }
 
     void VulkanCommandList::SetRootSignature(RootSignature* rootSignature) noexcept {
         m_RootSignature = INTERPRET_AS<VulkanRootSignature*>(rootSignature);
+        assert(BoundHeapsMatchRootSignature() && "Bound heap type does not match root signature descriptor space type.");
     }
 
     void VulkanCommandList::CopyBuffer(Buffer* src, Buffer* dst, size_t srcOffset, size_t dstOffset, size_t size) noexcept {
@@ -64,9 +93,22 @@ namespace RHINO::APIVulkan {
 
     void VulkanCommandList::SetComputePSO(ComputePSO* pso) noexcept {
         auto* vulkanPSO = static_cast<VulkanComputePSO*>(pso);
+        vulkanPSO->Wait();
+        if (vulkanPSO->IsFailed()) {
+            return;
+        }
+        m_ComputePSO = vulkanPSO;
         vkCmdBindPipeline(m_Cmd, VK_PIPELINE_BIND_POINT_COMPUTE, vulkanPSO->PSO);
     }
 
+    bool VulkanCommandList::TrySetComputePSO(ComputePSO* pso) noexcept {
+        if (!pso->IsReady() || pso->IsFailed()) {
+            return false;
+        }
+        SetComputePSO(pso);
+        return true;
+    }
+
     void VulkanCommandList::SetHeap(DescriptorHeap* CBVSRVUAVHeap, DescriptorHeap* SamplerHeap) noexcept {
         VkDescriptorBufferBindingInfoEXT bindings[2] = {};
         auto* vulkanCBVSRVUAVHeap = static_cast<VulkanDescriptorHeap*>(CBVSRVUAVHeap);
@@ -74,43 +116,131 @@ namespace RHINO::APIVulkan {
         bindingCBVSRVUAV.address = vulkanCBVSRVUAVHeap->GetHeapGPUStartHandle();
         bindingCBVSRVUAV.usage = VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT;
         bindings[0] = bindingCBVSRVUAV;
+        ReferenceHeapStorage(vulkanCBVSRVUAVHeap->GetStorage());
+        m_BoundCBVSRVUAVHeapType = vulkanCBVSRVUAVHeap->GetHeapType();
+        assert(BoundHeapsMatchRootSignature() && "Bound heap type does not match root signature descriptor space type.");
         if (SamplerHeap) {
             auto* vulkanSamplerHeap = static_cast<VulkanDescriptorHeap*>(SamplerHeap);
             VkDescriptorBufferBindingInfoEXT bindingSampler{VK_STRUCTURE_TYPE_DESCRIPTOR_BUFFER_BINDING_INFO_EXT};
             bindingSampler.address = vulkanSamplerHeap->GetHeapGPUStartHandle();
             bindingSampler.usage = VK_BUFFER_USAGE_SAMPLER_DESCRIPTOR_BUFFER_BIT_EXT | VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT;
             bindings[1] = bindingSampler;
+            ReferenceHeapStorage(vulkanSamplerHeap->GetStorage());
         }
         EXT::vkCmdBindDescriptorBuffersEXT(m_Cmd, SamplerHeap ? 2 : 1, bindings);
     }
 
     void VulkanCommandList::Dispatch(const DispatchDesc& desc) noexcept {
+        SetDescriptorBufferOffsets(VK_PIPELINE_BIND_POINT_COMPUTE);
+        vkCmdDispatch(m_Cmd, desc.dimensionsX, desc.dimensionsY, desc.dimensionsZ);
+    }
+
+    void VulkanCommandList::DispatchThreads(size_t threadsX, size_t threadsY, size_t threadsZ) noexcept {
+        assert(m_ComputePSO);
+        const Dim3D workgroupSize = m_ComputePSO->GetWorkgroupSize();
+        assert(workgroupSize.width && workgroupSize.height && workgroupSize.depth && "Workgroup size of compute PSO is unknown.");
+
+        const size_t groups[3] = {
+            (threadsX + workgroupSize.width - 1) / workgroupSize.width,
+            (threadsY + workgroupSize.height - 1) / workgroupSize.height,
+            (threadsZ + workgroupSize.depth - 1) / workgroupSize.depth,
+        };
+
+        const bool exceedsLimits = groups[0] > m_MaxWorkgroupCount[0] || groups[1] > m_MaxWorkgroupCount[1] ||
+                                   groups[2] > m_MaxWorkgroupCount[2];
+        if (!exceedsLimits) {
+            SetDescriptorBufferOffsets(VK_PIPELINE_BIND_POINT_COMPUTE);
+            vkCmdDispatch(m_Cmd, static_cast<uint32_t>(groups[0]), static_cast<uint32_t>(groups[1]), static_cast<uint32_t>(groups[2]));
+            return;
+        }
+        if (!m_ComputePSO->splitDispatches) {
+            assert(false && "Thread groups count exceeds maxComputeWorkGroupCount. Compile PSO with ComputePSODesc::splitDispatches.");
+            return;
+        }
+
+        SetDescriptorBufferOffsets(VK_PIPELINE_BIND_POINT_COMPUTE);
+        // Counts above device limits are split into several dispatches with base group offsets.
+        for (size_t baseZ = 0; baseZ < groups[2]; baseZ += m_MaxWorkgroupCount[2]) {
+            for (size_t baseY = 0; baseY < groups[1]; baseY += m_MaxWorkgroupCount[1]) {
+                for (size_t baseX = 0; baseX < groups[0]; baseX += m_MaxWorkgroupCount[0]) {
+                    const auto countX = static_cast<uint32_t>(std::min<size_t>(groups[0] - baseX, m_MaxWorkgroupCount[0]));
+                    const auto countY = static_cast<uint32_t>(std::min<size_t>(groups[1] - baseY, m_MaxWorkgroupCount[1]));
+                    const auto countZ = static_cast<uint32_t>(std::min<size_t>(groups[2] - baseZ, m_MaxWorkgroupCount[2]));
+                    vkCmdDispatchBase(m_Cmd, static_cast<uint32_t>(baseX), static_cast<uint32_t>(baseY), static_cast<uint32_t>(baseZ),
+                                      countX, countY, countZ);
+                }
+            }
+        }
+    }
+
+    void VulkanCommandList::SetDescriptorBufferOffsets(VkPipelineBindPoint bindPoint) noexcept {
+        assert(BoundHeapsMatchRootSignature() && "Bound heap type does not match root signature descriptor space type.");
         for (auto [space, spaceInfo] : m_RootSignature->heapOffsetsInDescriptorsBySpace) {
             uint32_t bufferIndex = spaceInfo.first == DescriptorHeapType::Sampler ? 1 : 0;
-            VkDeviceSize offset = spaceInfo.second;
-            switch (spaceInfo.first) {
-                case DescriptorHeapType::Sampler:
-                    offset *= CalculateDescriptorHandleIncrementSize(DescriptorHeapType::Sampler, m_DescriptorProps);
-                break;
-                default:
-                    offset *= CalculateDescriptorHandleIncrementSize(DescriptorHeapType::SRV_CBV_UAV, m_DescriptorProps);
-            }
-            EXT::vkCmdSetDescriptorBufferOffsetsEXT(m_Cmd, VK_PIPELINE_BIND_POINT_COMPUTE, m_RootSignature->layout,
+            VkDeviceSize offset = spaceInfo.second * CalculateDescriptorHandleIncrementSize(spaceInfo.first, m_DescriptorProps, m_Context);
+            EXT::vkCmdSetDescriptorBufferOffsetsEXT(m_Cmd, bindPoint, m_RootSignature->layout,
                                                     space, 1, &bufferIndex, &offset);
         }
+    }
 
-        vkCmdDispatch(m_Cmd, desc.dimensionsX, desc.dimensionsY, desc.dimensionsZ);
+    void VulkanCommandList::ReferenceHeapStorage(VulkanDescriptorHeapStorage* storage) noexcept {
+        if (std::find(m_RetiredObjects.begin(), m_RetiredObjects.end(), storage) != m_RetiredObjects.end()) {
+            return;
+        }
+        storage->AddRef();
+        m_RetiredObjects.push_back(storage);
+    }
+
+    bool VulkanCommandList::BoundHeapsMatchRootSignature() const noexcept {
+        if (!m_RootSignature || m_BoundCBVSRVUAVHeapType == DescriptorHeapType::Count) {
+            return true;
+        }
+        for (const auto& [space, spaceInfo] : m_RootSignature->heapOffsetsInDescriptorsBySpace) {
+            if (spaceInfo.first != DescriptorHeapType::Sampler && spaceInfo.first != m_BoundCBVSRVUAVHeapType) {
+                return false;
+            }
+        }
+        return true;
     }
 
     void VulkanCommandList::DispatchRays(const DispatchRaysDesc& desc) noexcept {
-        VkStridedDeviceAddressRegionKHR rayGenTable = {};
-        VkStridedDeviceAddressRegionKHR missTable = {};
-        VkStridedDeviceAddressRegionKHR higGroupTable = {};
-        VkStridedDeviceAddressRegionKHR callableTable = {NULL};
+        auto* vulkanPSO = static_cast<VulkanRTPSO*>(desc.pso);
+
+        vkCmdBindPipeline(m_Cmd, VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR, vulkanPSO->PSO);
+        SetHeap(desc.CDBSRVUAVHeap, desc.samplerHeap);
+        SetDescriptorBufferOffsets(VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR);
 
-        // TODO: calculate addresses;
+        const VkDeviceAddress tableAddress = vulkanPSO->shaderTableAddress;
+        const VkDeviceSize recordStride = vulkanPSO->tableRecordStride;
+        const std::vector<VkDeviceSize>& recordOffsets = vulkanPSO->recordOffsets;
+
+        // Region spans from start record to the end of its record type range in shader table.
+        auto makeRegion = [&](size_t startRecordIndex, VkDeviceSize regionBegin, VkDeviceSize regionEnd) {
+            VkStridedDeviceAddressRegionKHR region = {};
+            if (startRecordIndex >= recordOffsets.size() || regionBegin == regionEnd) {
+                return region;
+            }
+            const VkDeviceSize startOffset = recordOffsets[startRecordIndex];
+            assert(startOffset >= regionBegin && startOffset < regionEnd && "Start record has wrong record type.");
+            assert(startOffset % vulkanPSO->tableBaseAlignment == 0 && "Start record is not aligned to shaderGroupBaseAlignment.");
+            region.deviceAddress = tableAddress + startOffset;
+            region.stride = recordStride;
+            region.size = regionEnd - startOffset;
+            return region;
+        };
 
-        EXT::vkCmdTraceRaysKHR(m_Cmd, &rayGenTable, &missTable, &higGroupTable, &callableTable, desc.width, desc.height, 1);
+        VkStridedDeviceAddressRegionKHR rayGenTable = {};
+        rayGenTable.deviceAddress = tableAddress + recordOffsets[desc.rayGenerationShaderRecordIndex];
+        rayGenTable.stride = recordStride;
+        rayGenTable.size = recordStride;
+        VkStridedDeviceAddressRegionKHR missTable = makeRegion(desc.missShaderStartRecordIndex, vulkanPSO->missTableBegin,
+                                                               vulkanPSO->missTableEnd);
+        VkStridedDeviceAddressRegionKHR hitGroupTable = makeRegion(desc.hitGroupStartRecordIndex, vulkanPSO->hitGroupTableBegin,
+                                                                   vulkanPSO->hitGroupTableEnd);
+        VkStridedDeviceAddressRegionKHR callableTable = {};
+
+        EXT::vkCmdTraceRaysKHR(m_Cmd, &rayGenTable, &missTable, &hitGroupTable, &callableTable, static_cast<uint32_t>(desc.width),
+                               static_cast<uint32_t>(desc.height), 1);
     }
 
     void VulkanCommandList::Draw() noexcept {}
@@ -174,65 +304,265 @@ namespace RHINO::APIVulkan {
     }
 
     void VulkanCommandList::BuildRTPSO(RTPSO* pso) noexcept {
-        //TODO: impl
+        auto* vulkanPSO = static_cast<VulkanRTPSO*>(pso);
+        const std::vector<uint8_t>& tableData = vulkanPSO->shaderTableData;
+
+        // Shader tables are small, so they are written inline into command buffer instead of staging buffer copy.
+        constexpr size_t MaxUpdateSizeInBytes = 65536;
+        for (size_t offset = 0; offset < tableData.size(); offset += MaxUpdateSizeInBytes) {
+            const size_t size = std::min(tableData.size() - offset, MaxUpdateSizeInBytes);
+            vkCmdUpdateBuffer(m_Cmd, vulkanPSO->shaderTable, offset, size, tableData.data() + offset);
+        }
+
+        VkBufferMemoryBarrier barrier{VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER};
+        barrier.buffer = vulkanPSO->shaderTable;
+        barrier.offset = 0;
+        barrier.size = VK_WHOLE_SIZE;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        vkCmdPipelineBarrier(m_Cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR, 0, 0, nullptr, 1, &barrier,
+                             0, nullptr);
     }
 
     BLAS* VulkanCommandList::BuildBLAS(const BLASDesc& desc, Buffer* scratchBuffer, size_t scratchBufferStartOffset,
                                        const char* name) noexcept {
-        auto* indexBuffer = static_cast<VulkanBuffer*>(desc.indexBuffer);
-        auto* vertexBuffer = static_cast<VulkanBuffer*>(desc.vertexBuffer);
-        auto* transform = static_cast<VulkanBuffer*>(desc.transformBuffer);
+        BLAS* result = nullptr;
+        BuildBLASes(1, &desc, scratchBuffer, scratchBufferStartOffset, name, &result);
+        return result;
+    }
+
+    void VulkanCommandList::BuildBLASes(size_t count, const BLASDesc* descs, Buffer* scratchBuffer, size_t scratchBufferStartOffset,
+                                        const char* name, BLAS** outBLASes) noexcept {
+        if (count == 0) {
+            return;
+        }
+
         auto* scratch = static_cast<VulkanBuffer*>(scratchBuffer);
+        const VkDeviceAddress scratchAddress = scratch->deviceAddress + scratchBufferStartOffset;
+        assert(scratchAddress % m_ASScratchAlignment == 0 && "Scratch buffer start address is not aligned to AS scratch alignment.");
+
+        // Geometries of all BLASes are flattened, every build info points to its own range of them.
+        size_t geometriesCount = 0;
+        for (size_t i = 0; i < count; ++i) {
+            geometriesCount += descs[i].geometriesCount;
+        }
+        std::vector<VkAccelerationStructureGeometryKHR> geometries(geometriesCount);
+        std::vector<VkAccelerationStructureBuildRangeInfoKHR> rangeInfos(geometriesCount);
+        std::vector<uint32_t> primitiveCounts(geometriesCount);
+        std::vector<VkAccelerationStructureBuildGeometryInfoKHR> buildInfos(count);
+        std::vector<const VkAccelerationStructureBuildRangeInfoKHR*> rangeInfoPtrs(count);
+        std::vector<VkDeviceSize> asSizes(count);
+        std::vector<VkDeviceSize> storageOffsets(count);
+
+        // Same layout as VulkanBackend::GetBLASesPrebuildInfo reports.
+        VkDeviceSize storageSize = 0;
+        VkDeviceSize scratchOffset = 0;
+        size_t firstGeometry = 0;
+        for (size_t i = 0; i < count; ++i) {
+            for (size_t g = 0; g < descs[i].geometriesCount; ++g) {
+                geometries[firstGeometry + g] = GetBLASGeometry(descs[i].geometries[g]);
+                primitiveCounts[firstGeometry + g] = GetBLASPrimitiveCount(descs[i].geometries[g]);
+                rangeInfos[firstGeometry + g] = {};
+                rangeInfos[firstGeometry + g].primitiveCount = primitiveCounts[firstGeometry + g];
+            }
+            buildInfos[i] = GetBLASBuildInfo(geometries.data() + firstGeometry, static_cast<uint32_t>(descs[i].geometriesCount));
+            rangeInfoPtrs[i] = rangeInfos.data() + firstGeometry;
 
-        auto result = new VulkanBLAS{};
-
-        VkAccelerationStructureGeometryKHR asGeom{VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR};
-        asGeom.flags = VK_GEOMETRY_OPAQUE_BIT_KHR;
-        asGeom.geometryType = VK_GEOMETRY_TYPE_TRIANGLES_KHR;
-        asGeom.geometry.triangles.indexType = Convert::ToVkIndexType(desc.indexFormat);
-        asGeom.geometry.triangles.indexData = {indexBuffer->deviceAddress + desc.indexBufferStartOffset};
-        asGeom.geometry.triangles.vertexStride = desc.vertexStride;
-        asGeom.geometry.triangles.vertexFormat = Convert::ToVkFormat(desc.vertexFormat);
-        asGeom.geometry.triangles.vertexData = {vertexBuffer->deviceAddress + desc.vertexBufferStartOffset};
-        asGeom.geometry.triangles.maxVertex = desc.vertexCount;
-        asGeom.geometry.triangles.transformData = {transform->deviceAddress + desc.transformBufferStartOffset};
-
-        VkAccelerationStructureBuildGeometryInfoKHR buildInfo{};
-        buildInfo.dstAccelerationStructure = VK_NULL_HANDLE;
-        buildInfo.flags = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR |
-                             VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR;
-        buildInfo.mode = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
-        buildInfo.type = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
-        buildInfo.geometryCount = 1;
-        buildInfo.pGeometries = &asGeom;
-        buildInfo.ppGeometries = nullptr;
-
-        VkAccelerationStructureBuildSizesInfoKHR outSizesInfo{VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR};
-        EXT::vkGetAccelerationStructureBuildSizesKHR(m_Context.device, VK_ACCELERATION_STRUCTURE_BUILD_TYPE_DEVICE_KHR, &buildInfo, nullptr,
-                                                     &outSizesInfo);
+            VkAccelerationStructureBuildSizesInfoKHR sizes{VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR};
+            EXT::vkGetAccelerationStructureBuildSizesKHR(m_Context.device, VK_ACCELERATION_STRUCTURE_BUILD_TYPE_DEVICE_KHR, &buildInfos[i],
+                                                         primitiveCounts.data() + firstGeometry, &sizes);
+            firstGeometry += descs[i].geometriesCount;
+
+            asSizes[i] = sizes.accelerationStructureSize;
+            storageOffsets[i] = storageSize;
+            storageSize += RHINO_CEIL_TO_MULTIPLE_OF(sizes.accelerationStructureSize, ASStorageOffsetAlignment);
+
+            buildInfos[i].scratchData.deviceAddress = scratchAddress + scratchOffset;
+            scratchOffset += RHINO_CEIL_TO_MULTIPLE_OF(sizes.buildScratchSize, m_ASScratchAlignment);
+        }
+
+        // All BLASes of the batch share one buffer and one memory allocation.
+        VulkanASStorage* storage = CreateASStorage(storageSize, static_cast<uint32_t>(count), name);
+        for (size_t i = 0; i < count; ++i) {
+            VulkanBLAS* result = CreateBLAS(storage, storageOffsets[i], asSizes[i]);
+            buildInfos[i].dstAccelerationStructure = result->accelerationStructure;
+            outBLASes[i] = result;
+        }
+
+        EXT::vkCmdBuildAccelerationStructuresKHR(m_Cmd, static_cast<uint32_t>(count), buildInfos.data(), rangeInfoPtrs.data());
+    }
+
+    void VulkanCommandList::QueryBLASCompactedSizes(size_t count, BLAS* const* blases) noexcept {
+        WriteBLASSizeQueries(count, blases, VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR, &VulkanBLAS::compactedSizeQuery);
+    }
+
+    void VulkanCommandList::QueryBLASSerializedSizes(size_t count, BLAS* const* blases) noexcept {
+        WriteBLASSizeQueries(count, blases, VK_QUERY_TYPE_ACCELERATION_STRUCTURE_SERIALIZATION_SIZE_KHR, &VulkanBLAS::serializedSizeQuery);
+    }
+
+    void VulkanCommandList::WriteBLASSizeQueries(size_t count, BLAS* const* blases, VkQueryType queryType,
+                                                 VulkanASSizeQuery VulkanBLAS::*query) noexcept {
+        if (count == 0) {
+            return;
+        }
+
+        auto* pool = new VulkanASSizeQueryPool{};
+        pool->context = m_Context;
+        pool->refCount = static_cast<uint32_t>(count);
+
+        VkQueryPoolCreateInfo createInfo{VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO};
+        createInfo.queryType = queryType;
+        createInfo.queryCount = static_cast<uint32_t>(count);
+        RHINO_VKS(vkCreateQueryPool(m_Context.device, &createInfo, m_Context.allocator, &pool->queryPool));
+        // Reset from host, so results can be polled right away and report not ready instead of undefined state.
+        vkResetQueryPool(m_Context.device, pool->queryPool, 0, static_cast<uint32_t>(count));
+
+        std::vector<VkAccelerationStructureKHR> structures(count);
+        for (size_t i = 0; i < count; ++i) {
+            auto* vulkanBLAS = static_cast<VulkanBLAS*>(blases[i]);
+            (vulkanBLAS->*query).Reset(pool, static_cast<uint32_t>(i));
+            structures[i] = vulkanBLAS->accelerationStructure;
+        }
 
+        // Builds have to be finished before their properties are written.
+        VkMemoryBarrier barrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+        barrier.srcAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+        barrier.dstAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR;
+        vkCmdPipelineBarrier(m_Cmd, VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+                             VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+        EXT::vkCmdWriteAccelerationStructuresPropertiesKHR(m_Cmd, static_cast<uint32_t>(count), structures.data(), queryType,
+                                                           pool->queryPool, 0);
+    }
+
+    void VulkanCommandList::CompactBLASes(size_t count, BLAS* const* blases, const char* name, BLAS** outCompacted) noexcept {
+        if (count == 0) {
+            return;
+        }
+
+        std::vector<VkDeviceSize> compactedSizes(count);
+        std::vector<VkDeviceSize> storageOffsets(count);
+        VkDeviceSize storageSize = 0;
+        for (size_t i = 0; i < count; ++i) {
+            auto* vulkanBLAS = static_cast<VulkanBLAS*>(blases[i]);
+            const bool sizeReady = vulkanBLAS->compactedSizeQuery.GetResult(&compactedSizes[i]);
+            assert(sizeReady && "BLAS compacted size is not read back yet.");
+            if (!sizeReady) {
+                compactedSizes[i] = vulkanBLAS->size;
+            }
+            storageOffsets[i] = storageSize;
+            storageSize += RHINO_CEIL_TO_MULTIPLE_OF(compactedSizes[i], ASStorageOffsetAlignment);
+        }
+
+        // Compacted BLASes of the batch share one right-sized buffer and memory allocation.
+        VulkanASStorage* storage = CreateASStorage(storageSize, static_cast<uint32_t>(count), name);
+
+        for (size_t i = 0; i < count; ++i) {
+            auto* source = static_cast<VulkanBLAS*>(blases[i]);
+            VulkanBLAS* result = CreateBLAS(storage, storageOffsets[i], compactedSizes[i]);
+
+            VkCopyAccelerationStructureInfoKHR copyInfo{VK_STRUCTURE_TYPE_COPY_ACCELERATION_STRUCTURE_INFO_KHR};
+            copyInfo.src = source->accelerationStructure;
+            copyInfo.dst = result->accelerationStructure;
+            copyInfo.mode = VK_COPY_ACCELERATION_STRUCTURE_MODE_COMPACT_KHR;
+            EXT::vkCmdCopyAccelerationStructureKHR(m_Cmd, &copyInfo);
+
+            m_CompactedSources.push_back(source);
+            outCompacted[i] = result;
+        }
+    }
+
+    void VulkanCommandList::SerializeBLAS(BLAS* blas, Buffer* dstBuffer, size_t dstBufferStartOffset) noexcept {
+        auto* vulkanBLAS = static_cast<VulkanBLAS*>(blas);
+        auto* dst = static_cast<VulkanBuffer*>(dstBuffer);
+        assert((dst->deviceAddress + dstBufferStartOffset) % ASStorageOffsetAlignment == 0 && "Serialized BLAS destination is not aligned.");
+
+        // Build has to be finished before the structure is serialized.
+        VkMemoryBarrier buildBarrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+        buildBarrier.srcAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+        buildBarrier.dstAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR;
+        vkCmdPipelineBarrier(m_Cmd, VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+                             VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, 0, 1, &buildBarrier, 0, nullptr, 0, nullptr);
+
+        VkCopyAccelerationStructureToMemoryInfoKHR copyInfo{VK_STRUCTURE_TYPE_COPY_ACCELERATION_STRUCTURE_TO_MEMORY_INFO_KHR};
+        copyInfo.src = vulkanBLAS->accelerationStructure;
+        copyInfo.dst.deviceAddress = dst->deviceAddress + dstBufferStartOffset;
+        copyInfo.mode = VK_COPY_ACCELERATION_STRUCTURE_MODE_SERIALIZE_KHR;
+        EXT::vkCmdCopyAccelerationStructureToMemoryKHR(m_Cmd, &copyInfo);
+
+        // Blob is read on host once the command list finishes execution.
+        VkMemoryBarrier hostBarrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+        hostBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        hostBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+        vkCmdPipelineBarrier(m_Cmd, VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &hostBarrier, 0,
+                             nullptr, 0, nullptr);
+    }
+
+    BLAS* VulkanCommandList::DeserializeBLAS(const SerializedASInfo& info, Buffer* srcBuffer, size_t srcBufferStartOffset,
+                                             const char* name) noexcept {
+        if (!info.compatible) {
+            return nullptr;
+        }
+        auto* src = static_cast<VulkanBuffer*>(srcBuffer);
+        assert((src->deviceAddress + srcBufferStartOffset) % ASStorageOffsetAlignment == 0 && "Serialized BLAS source is not aligned.");
+
+        VulkanASStorage* storage = CreateASStorage(info.deserializedSizeInBytes, 1, name);
+        VulkanBLAS* result = CreateBLAS(storage, 0, info.deserializedSizeInBytes);
+
+        VkCopyMemoryToAccelerationStructureInfoKHR copyInfo{VK_STRUCTURE_TYPE_COPY_MEMORY_TO_ACCELERATION_STRUCTURE_INFO_KHR};
+        copyInfo.src.deviceAddress = src->deviceAddress + srcBufferStartOffset;
+        copyInfo.dst = result->accelerationStructure;
+        copyInfo.mode = VK_COPY_ACCELERATION_STRUCTURE_MODE_DESERIALIZE_KHR;
+        EXT::vkCmdCopyMemoryToAccelerationStructureKHR(m_Cmd, &copyInfo);
+        return result;
+    }
+
+    VulkanASStorage* VulkanCommandList::CreateASStorage(VkDeviceSize size, uint32_t structuresCount, const char* name) noexcept {
+        auto* result = new VulkanASStorage{};
+        result->context = m_Context;
+        result->refCount = structuresCount;
 
         VkBufferCreateInfo bufferInfo{VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
-        bufferInfo.size = outSizesInfo.accelerationStructureSize;
+        bufferInfo.size = size;
         bufferInfo.usage = VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
         bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-        vkCreateBuffer(m_Context.device, &bufferInfo, m_Context.allocator, &result->buffer);
+        RHINO_VKS(vkCreateBuffer(m_Context.device, &bufferInfo, m_Context.allocator, &result->buffer));
+        RHINO_GPU_DEBUG(SetDebugName(m_Context.device, result->buffer, VK_OBJECT_TYPE_BUFFER, name));
 
-        // TODO: allocate buffer memory
+        VkMemoryRequirements memReqs;
+        vkGetBufferMemoryRequirements(m_Context.device, result->buffer, &memReqs);
 
-        VkAccelerationStructureCreateInfoKHR createInfo{VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR};
-        createInfo.type = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
-        createInfo.buffer = result->buffer;
-        createInfo.deviceAddress = NULL;
-        createInfo.offset = 0;
-        createInfo.size = outSizesInfo.accelerationStructureSize;
-        createInfo.createFlags = 0;
+        VkMemoryAllocateFlagsInfo allocateFlagsInfo{VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO};
+        allocateFlagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
 
-        EXT::vkCreateAccelerationStructureKHR(m_Context.device, &createInfo, m_Context.allocator, &result->accelerationStructure);
+        VkMemoryAllocateInfo alloc{VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO};
+        alloc.pNext = &allocateFlagsInfo;
+        alloc.allocationSize = memReqs.size;
+        alloc.memoryTypeIndex = SelectMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_Context);
+        RHINO_VKS(vkAllocateMemory(m_Context.device, &alloc, m_Context.allocator, &result->memory));
+        vkBindBufferMemory(m_Context.device, result->buffer, result->memory, 0);
+        return result;
+    }
 
-        buildInfo.scratchData = {scratch->deviceAddress};
-        buildInfo.dstAccelerationStructure = result->accelerationStructure;
-        EXT::vkCmdBuildAccelerationStructuresKHR(m_Cmd, 1, &buildInfo, nullptr);
+    VulkanBLAS* VulkanCommandList::CreateBLAS(VulkanASStorage* storage, VkDeviceSize storageOffset, VkDeviceSize size) noexcept {
+        auto* result = new VulkanBLAS{};
+        result->context = m_Context;
+        result->storage = storage;
+        result->storageOffset = storageOffset;
+        result->size = size;
+
+        VkAccelerationStructureCreateInfoKHR createInfo{VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR};
+        createInfo.type = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
+        createInfo.buffer = storage->buffer;
+        createInfo.offset = storageOffset;
+        createInfo.size = size;
+        RHINO_VKS(EXT::vkCreateAccelerationStructureKHR(m_Context.device, &createInfo, m_Context.allocator, &result->accelerationStructure));
+
+        VkAccelerationStructureDeviceAddressInfoKHR addressInfo{VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_DEVICE_ADDRESS_INFO_KHR};
+        addressInfo.accelerationStructure = result->accelerationStructure;
+        result->deviceAddress = EXT::vkGetAccelerationStructureDeviceAddressKHR(m_Context.device, &addressInfo);
         return result;
     }
 
@@ -240,53 +570,143 @@ namespace RHINO::APIVulkan {
                                        const char* name) noexcept {
         auto* scratch = static_cast<VulkanBuffer*>(scratchBuffer);
 
-        auto result = new VulkanTLAS{};
-
-        for (size_t i = 0; i < desc.blasInstancesCount; ++i) {
-            const BLASInstanceDesc& instanceDesc = desc.blasInstances[i];
-            VkAccelerationStructureInstanceKHR nativeInstanceDesc{};
-            nativeInstanceDesc.flags = 0;
-            nativeInstanceDesc.mask = instanceDesc.instanceMask;
-            nativeInstanceDesc.instanceCustomIndex = instanceDesc.instanceID;
-            nativeInstanceDesc.instanceShaderBindingTableRecordOffset = 0;
-            // nativeInstanceDesc.accelerationStructureReference = ;
-            memcpy(nativeInstanceDesc.transform.matrix, instanceDesc.transform, sizeof(instanceDesc.transform));
-
-            //TODO: copy it to mapped buffer and upload
-        }
-
-        VkAccelerationStructureGeometryInstancesDataKHR instancesDesc{VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_INSTANCES_DATA_KHR};
-        // instancesDesc.data.deviceAddress = instBufferAddr;
-        instancesDesc.arrayOfPointers = VK_FALSE;
+        auto* result = new VulkanTLAS{};
+        result->context = m_Context;
+        result->allowUpdate = desc.allowUpdate;
+        result->instancesCount = desc.blasInstancesCount;
+        VulkanTLASInstanceBuffer* instanceBuffer = AcquireTLASInstanceBuffer(result);
+        WriteTLASInstances(instanceBuffer, desc);
 
-        VkAccelerationStructureGeometryKHR geoDesc{VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR};
-        geoDesc.geometryType = VK_GEOMETRY_TYPE_INSTANCES_KHR;
-        geoDesc.geometry.instances = instancesDesc;
+        const VkAccelerationStructureGeometryKHR geometry = GetTLASGeometry(instanceBuffer->deviceAddress);
+        VkAccelerationStructureBuildGeometryInfoKHR buildInfo = GetTLASBuildInfo(&geometry, desc.allowUpdate);
 
-        VkAccelerationStructureBuildGeometryInfoKHR buildInfo{VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR};
-        buildInfo.flags = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR;
-        buildInfo.geometryCount = 1;
-        buildInfo.pGeometries = &geoDesc;
-        buildInfo.mode = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
-        buildInfo.type = VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR;
-        buildInfo.srcAccelerationStructure = VK_NULL_HANDLE;
+        VkAccelerationStructureBuildRangeInfoKHR rangeInfo{};
+        rangeInfo.primitiveCount = static_cast<uint32_t>(desc.blasInstancesCount);
+        const VkAccelerationStructureBuildRangeInfoKHR* rangeInfoPtr = &rangeInfo;
 
         VkAccelerationStructureBuildSizesInfoKHR sizeInfo{VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR};
-        EXT::vkGetAccelerationStructureBuildSizesKHR(m_Context.device, VK_ACCELERATION_STRUCTURE_BUILD_TYPE_DEVICE_KHR, &buildInfo, nullptr,
-                                                     &sizeInfo);
+        EXT::vkGetAccelerationStructureBuildSizesKHR(m_Context.device, VK_ACCELERATION_STRUCTURE_BUILD_TYPE_DEVICE_KHR, &buildInfo,
+                                                     &rangeInfo.primitiveCount, &sizeInfo);
+
+        result->storage = CreateASStorage(sizeInfo.accelerationStructureSize, 1, name);
 
         VkAccelerationStructureCreateInfoKHR createInfo{VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR};
         createInfo.type = VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR;
-        createInfo.size = sizeInfo.accelerationStructureSize;
-        createInfo.createFlags = 0;
+        createInfo.buffer = result->storage->buffer;
         createInfo.offset = 0;
-        EXT::vkCreateAccelerationStructureKHR(m_Context.device, &createInfo, m_Context.allocator, &result->accelerationStructure);
+        createInfo.size = sizeInfo.accelerationStructureSize;
+        RHINO_VKS(EXT::vkCreateAccelerationStructureKHR(m_Context.device, &createInfo, m_Context.allocator, &result->accelerationStructure));
 
-        buildInfo.scratchData = {scratch->deviceAddress};
+        VkAccelerationStructureDeviceAddressInfoKHR addressInfo{VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_DEVICE_ADDRESS_INFO_KHR};
+        addressInfo.accelerationStructure = result->accelerationStructure;
+        result->deviceAddress = EXT::vkGetAccelerationStructureDeviceAddressKHR(m_Context.device, &addressInfo);
+
+        const VkDeviceAddress scratchAddress = scratch->deviceAddress + scratchBufferStartOffset;
+        assert(scratchAddress % m_ASScratchAlignment == 0 && "Scratch buffer start address is not aligned to AS scratch alignment.");
+        buildInfo.scratchData.deviceAddress = scratchAddress;
         buildInfo.dstAccelerationStructure = result->accelerationStructure;
-        EXT::vkCmdBuildAccelerationStructuresKHR(m_Cmd, 1, &buildInfo, nullptr);
+        EXT::vkCmdBuildAccelerationStructuresKHR(m_Cmd, 1, &buildInfo, &rangeInfoPtr);
         return result;
     }
+
+    void VulkanCommandList::UpdateTLAS(TLAS* tlas, const TLASDesc& desc, Buffer* scratchBuffer, size_t scratchBufferStartOffset) noexcept {
+        auto* vulkanTLAS = static_cast<VulkanTLAS*>(tlas);
+        auto* scratch = static_cast<VulkanBuffer*>(scratchBuffer);
+        assert(vulkanTLAS->allowUpdate && "TLAS was built without allowUpdate.");
+        assert(vulkanTLAS->instancesCount == desc.blasInstancesCount && "TLAS update can't change instances count.");
+
+        // Instances are written at record time, so they go to a buffer that previously recorded builds do not read.
+        VulkanTLASInstanceBuffer* instanceBuffer = AcquireTLASInstanceBuffer(vulkanTLAS);
+        WriteTLASInstances(instanceBuffer, desc);
+
+        const VkAccelerationStructureGeometryKHR geometry = GetTLASGeometry(instanceBuffer->deviceAddress);
+        VkAccelerationStructureBuildGeometryInfoKHR buildInfo = GetTLASBuildInfo(&geometry, true);
+        buildInfo.mode = VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR;
+        buildInfo.srcAccelerationStructure = vulkanTLAS->accelerationStructure;
+        buildInfo.dstAccelerationStructure = vulkanTLAS->accelerationStructure;
+
+        const VkDeviceAddress scratchAddress = scratch->deviceAddress + scratchBufferStartOffset;
+        assert(scratchAddress % m_ASScratchAlignment == 0 && "Scratch buffer start address is not aligned to AS scratch alignment.");
+        buildInfo.scratchData.deviceAddress = scratchAddress;
+
+        VkAccelerationStructureBuildRangeInfoKHR rangeInfo{};
+        rangeInfo.primitiveCount = static_cast<uint32_t>(desc.blasInstancesCount);
+        const VkAccelerationStructureBuildRangeInfoKHR* rangeInfoPtr = &rangeInfo;
+
+        // Orders update after AS build or update of this TLAS recorded earlier in the same command list.
+        // Host writes of instances are made visible by the queue submission.
+        VkMemoryBarrier barrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+        barrier.srcAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+        barrier.dstAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR | VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+        vkCmdPipelineBarrier(m_Cmd, VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+                             VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+        EXT::vkCmdBuildAccelerationStructuresKHR(m_Cmd, 1, &buildInfo, &rangeInfoPtr);
+    }
+
+    VulkanTLASInstanceBuffer* VulkanCommandList::CreateTLASInstanceBuffer(size_t instancesCount) noexcept {
+        auto* result = new VulkanTLASInstanceBuffer{};
+        result->context = m_Context;
+        result->refCount = 1;
+
+        VkBufferCreateInfo bufferInfo{VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+        bufferInfo.size = std::max<size_t>(instancesCount, 1) * sizeof(VkAccelerationStructureInstanceKHR);
+        bufferInfo.usage = VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        RHINO_VKS(vkCreateBuffer(m_Context.device, &bufferInfo, m_Context.allocator, &result->buffer));
+
+        VkMemoryRequirements memReqs;
+        vkGetBufferMemoryRequirements(m_Context.device, result->buffer, &memReqs);
+
+        VkMemoryAllocateFlagsInfo allocateFlagsInfo{VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO};
+        allocateFlagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
+
+        VkMemoryAllocateInfo alloc{VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO};
+        alloc.pNext = &allocateFlagsInfo;
+        alloc.allocationSize = memReqs.size;
+        alloc.memoryTypeIndex = SelectMemoryType(memReqs.memoryTypeBits,
+                                                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_Context);
+        RHINO_VKS(vkAllocateMemory(m_Context.device, &alloc, m_Context.allocator, &result->memory));
+        vkBindBufferMemory(m_Context.device, result->buffer, result->memory, 0);
+        RHINO_VKS(vkMapMemory(m_Context.device, result->memory, 0, VK_WHOLE_SIZE, 0, reinterpret_cast<void**>(&result->mapped)));
+
+        // Forces the first write of every instance.
+        result->instances.resize(instancesCount);
+        memset(result->instances.data(), 0xFF, result->instances.size() * sizeof(VkAccelerationStructureInstanceKHR));
+
+        VkBufferDeviceAddressInfo addressInfo{VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO};
+        addressInfo.buffer = result->buffer;
+        result->deviceAddress = vkGetBufferDeviceAddress(m_Context.device, &addressInfo);
+        return result;
+    }
+
+    VulkanTLASInstanceBuffer* VulkanCommandList::AcquireTLASInstanceBuffer(VulkanTLAS* tlas) noexcept {
+        VulkanTLASInstanceBuffer* result = nullptr;
+        for (VulkanTLASInstanceBuffer* instanceBuffer : tlas->instanceBuffers) {
+            if (instanceBuffer->IsIdle()) {
+                result = instanceBuffer;
+                break;
+            }
+        }
+        if (!result) {
+            result = CreateTLASInstanceBuffer(tlas->instancesCount);
+            tlas->instanceBuffers.push_back(result);
+        }
+
+        result->AddRef();
+        m_RetiredObjects.push_back(result);
+        return result;
+    }
+
+    void VulkanCommandList::WriteTLASInstances(VulkanTLASInstanceBuffer* instanceBuffer, const TLASDesc& desc) noexcept {
+        static_assert(sizeof(VkAccelerationStructureInstanceKHR) == sizeof(PackedASInstance));
+        static_assert(offsetof(VkAccelerationStructureInstanceKHR, accelerationStructureReference) == offsetof(PackedASInstance, blasAddress));
+
+        // Mapped memory may be uncached, so instances are compared against the host copy instead.
+        PackASInstances(desc.blasInstances, desc.blasInstancesCount, reinterpret_cast<PackedASInstance*>(instanceBuffer->instances.data()),
+                        reinterpret_cast<PackedASInstance*>(instanceBuffer->mapped),
+                        [](BLAS* blas) { return static_cast<VulkanBLAS*>(blas)->deviceAddress; });
+    }
 } // namespace RHINO::APIVulkan
 
 #endif// ENABLE_API_VULKAN
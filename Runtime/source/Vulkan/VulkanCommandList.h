@@ -3,19 +3,26 @@
 #ifdef ENABLE_API_VULKAN
 
 #include "VulkanBackendTypes.h"
+#include "VulkanGarbageCollector.h"
 
 namespace RHINO::APIVulkan {
+    class VulkanDescriptorHeapStorage;
+
     class VulkanCommandList : public CommandList {
     public:
-        void Initialize(const char* name, VulkanObjectContext context, uint32_t queueFamilyIdx) noexcept;
+        void Initialize(const char* name, VulkanObjectContext context, uint32_t queueFamilyIdx, VkDeviceSize asScratchAlignment,
+                        VulkanGarbageCollector* garbageCollector) noexcept;
         void SubmitToQueue(VkQueue queue) noexcept;
 
     public:
+        void Reset() noexcept final;
         void SetRootSignature(RootSignature* rootSignature) noexcept final;
         void CopyBuffer(Buffer* src, Buffer* dst, size_t srcOffset, size_t dstOffset, size_t size) noexcept final;
         void SetComputePSO(ComputePSO* pso) noexcept final;
+        bool TrySetComputePSO(ComputePSO* pso) noexcept final;
         void SetHeap(DescriptorHeap* CBVSRVUAVHeap, DescriptorHeap* SamplerHeap) noexcept final;
         void Dispatch(const DispatchDesc& desc) noexcept final;
+        void DispatchThreads(size_t threadsX, size_t threadsY, size_t threadsZ) noexcept final;
         void DispatchRays(const DispatchRaysDesc& desc) noexcept final;
         void Draw() noexcept final;
         void ResourceBarrier(const ResourceBarrierDesc& desc) noexcept final;
@@ -26,15 +33,50 @@ namespace RHINO::APIVulkan {
     public:
         void BuildRTPSO(RTPSO* pso) noexcept final;
         BLAS* BuildBLAS(const BLASDesc& desc, Buffer* scratchBuffer, size_t scratchBufferStartOffset, const char* name) noexcept final;
+        void BuildBLASes(size_t count, const BLASDesc* descs, Buffer* scratchBuffer, size_t scratchBufferStartOffset, const char* name,
+                         BLAS** outBLASes) noexcept final;
+        void QueryBLASCompactedSizes(size_t count, BLAS* const* blases) noexcept final;
+        void CompactBLASes(size_t count, BLAS* const* blases, const char* name, BLAS** outCompacted) noexcept final;
+        void QueryBLASSerializedSizes(size_t count, BLAS* const* blases) noexcept final;
+        void SerializeBLAS(BLAS* blas, Buffer* dstBuffer, size_t dstBufferStartOffset) noexcept final;
+        BLAS* DeserializeBLAS(const SerializedASInfo& info, Buffer* srcBuffer, size_t srcBufferStartOffset, const char* name) noexcept final;
         TLAS* BuildTLAS(const TLASDesc& desc, Buffer* scratchBuffer, size_t scratchBufferStartOffset, const char* name) noexcept final;
+        void UpdateTLAS(TLAS* tlas, const TLASDesc& desc, Buffer* scratchBuffer, size_t scratchBufferStartOffset) noexcept final;
+
+    private:
+        void BeginRecording() noexcept;
+        void SetDescriptorBufferOffsets(VkPipelineBindPoint bindPoint) noexcept;
+        // All non sampler spaces are offsets in the bound SRV_CBV_UAV heap, so their types must match its type.
+        bool BoundHeapsMatchRootSignature() const noexcept;
+        // Keeps bound heap storage alive until this command list is executed, even if the heap grows meanwhile.
+        void ReferenceHeapStorage(VulkanDescriptorHeapStorage* storage) noexcept;
+        VulkanASStorage* CreateASStorage(VkDeviceSize size, uint32_t structuresCount, const char* name) noexcept;
+        VulkanBLAS* CreateBLAS(VulkanASStorage* storage, VkDeviceSize storageOffset, VkDeviceSize size) noexcept;
+        // Writes sizes of queryType to one query pool shared by BLASes, each BLAS gets its slot in query member.
+        void WriteBLASSizeQueries(size_t count, BLAS* const* blases, VkQueryType queryType, VulkanASSizeQuery VulkanBLAS::*query) noexcept;
+        VulkanTLASInstanceBuffer* CreateTLASInstanceBuffer(size_t instancesCount) noexcept;
+        // Returns instance buffer of TLAS no recorded or executing build reads, referenced by this command list.
+        VulkanTLASInstanceBuffer* AcquireTLASInstanceBuffer(VulkanTLAS* tlas) noexcept;
+        // Writes only instances that differ from the ones written to this buffer before.
+        void WriteTLASInstances(VulkanTLASInstanceBuffer* instanceBuffer, const TLASDesc& desc) noexcept;
 
     private:
         VulkanObjectContext m_Context = {};
         VkCommandBuffer m_Cmd = VK_NULL_HANDLE;
         VkCommandPool m_Pool = VK_NULL_HANDLE;
         VulkanRootSignature* m_RootSignature = nullptr;
+        VulkanComputePSO* m_ComputePSO = nullptr;
+        DescriptorHeapType m_BoundCBVSRVUAVHeapType = DescriptorHeapType::Count;
 
         VkPhysicalDeviceDescriptorBufferPropertiesEXT m_DescriptorProps = {};
+        uint32_t m_MaxWorkgroupCount[3] = {};
+        VkDeviceSize m_ASScratchAlignment = 1;
+
+        VulkanGarbageCollector* m_GarbageCollector = nullptr;
+        // Objects released by the garbage collector after this command list is executed.
+        std::vector<Object*> m_RetiredObjects{};
+        // Compacted BLASes sources, owned by the caller until this command list is submitted, retired on submission.
+        std::vector<Object*> m_CompactedSources{};
     };
 }// namespace RHINO::APIVulkan
 
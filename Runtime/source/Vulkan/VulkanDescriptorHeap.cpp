@@ -6,8 +6,11 @@
 
 namespace RHINO::APIVulkan {
     void VulkanDescriptorHeap::Initialize(const char* name, DescriptorHeapType type, size_t descriptorsCount,
-                                          VulkanObjectContext context) noexcept {
+                                          VulkanObjectContext context, VulkanGarbageCollector* garbageCollector) noexcept {
         m_Context = context;
+        m_GarbageCollector = garbageCollector;
+        m_HeapType = type;
+        m_DescriptorsCount = descriptorsCount;
 
         VkPhysicalDeviceDescriptorBufferPropertiesEXT descriptorProps{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_PROPERTIES_EXT};
         VkPhysicalDeviceProperties2 props{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2};
@@ -16,27 +19,51 @@ namespace RHINO::APIVulkan {
 
         m_DescriptorProps = descriptorProps;
 
-        m_DescriptorHandleIncrementSize = CalculateDescriptorHandleIncrementSize(type, descriptorProps);
+        m_DescriptorHandleIncrementSize = CalculateDescriptorHandleIncrementSize(type, descriptorProps, m_Context);
+        m_HeapPadding = CalculateDescriptorHeapPadding(type, m_Context);
 
-        // TODO: 256 is just a magic number for RTX 3080TI.
-        //  For some reason descriptorProps.descriptorBufferOffsetAlignment != 256.
-        //  Research valid parameter for this one.
-        const VkDeviceSize dbAlignment = descriptorProps.descriptorBufferOffsetAlignment;
-        m_HeapSize = RHINO_CEIL_TO_MULTIPLE_OF(m_DescriptorHandleIncrementSize * descriptorsCount + 256, dbAlignment);
+        AllocateHeapStorage(descriptorsCount);
+
+        m_ImageViewPerDescriptor.resize(descriptorsCount);
+    }
+
+    void VulkanDescriptorHeap::Grow(size_t newDescriptorsCount) noexcept {
+        if (newDescriptorsCount <= m_DescriptorsCount) {
+            return;
+        }
+
+        VulkanDescriptorHeapStorage* oldStorage = m_Storage;
+        AllocateHeapStorage(newDescriptorsCount);
+        memcpy(m_Mapped, oldStorage->mapped, m_DescriptorHandleIncrementSize * m_DescriptorsCount);
+
+        // Command lists recorded with the old storage hold their own references to it.
+        oldStorage->Release();
+
+        m_ImageViewPerDescriptor.resize(newDescriptorsCount);
+        m_DescriptorsCount = newDescriptorsCount;
+    }
+
+    void VulkanDescriptorHeap::AllocateHeapStorage(size_t descriptorsCount) noexcept {
+        const VkDeviceSize dbAlignment = m_DescriptorProps.descriptorBufferOffsetAlignment;
+        m_HeapSize = RHINO_CEIL_TO_MULTIPLE_OF(m_DescriptorHandleIncrementSize * descriptorsCount + m_HeapPadding, dbAlignment);
 
         VkBufferCreateInfo heapCreateInfo{VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
         heapCreateInfo.flags = 0;
         heapCreateInfo.usage = VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
-        if (type == DescriptorHeapType::Sampler) {
+        if (m_HeapType == DescriptorHeapType::Sampler) {
             heapCreateInfo.usage |= VK_BUFFER_USAGE_SAMPLER_DESCRIPTOR_BUFFER_BIT_EXT;
         }
         heapCreateInfo.size = m_HeapSize;
         heapCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-        RHINO_VKS(vkCreateBuffer(m_Context.device, &heapCreateInfo, m_Context.allocator, &m_Heap));
+
+        m_Storage = new VulkanDescriptorHeapStorage{};
+        m_Storage->refCount = 1;
+        m_Storage->context = m_Context;
+        RHINO_VKS(vkCreateBuffer(m_Context.device, &heapCreateInfo, m_Context.allocator, &m_Storage->buffer));
 
         // Create the memory backing up the buffer handle
         VkMemoryRequirements memReqs;
-        vkGetBufferMemoryRequirements(m_Context.device, m_Heap, &memReqs);
+        vkGetBufferMemoryRequirements(m_Context.device, m_Storage->buffer, &memReqs);
         VkPhysicalDeviceMemoryProperties memoryProps;
         vkGetPhysicalDeviceMemoryProperties(m_Context.physicalDevice, &memoryProps);
 
@@ -48,23 +75,57 @@ namespace RHINO::APIVulkan {
         alloc.pNext = &allocateFlagsInfo;
         alloc.allocationSize = memReqs.size;
         alloc.memoryTypeIndex = SelectMemoryType(0xffffff, memoryFlags, m_Context);
-        RHINO_VKS(vkAllocateMemory(m_Context.device, &alloc, m_Context.allocator, &m_Memory));
+        RHINO_VKS(vkAllocateMemory(m_Context.device, &alloc, m_Context.allocator, &m_Storage->memory));
 
-        RHINO_VKS(vkBindBufferMemory(m_Context.device, m_Heap, m_Memory, 0));
+        RHINO_VKS(vkBindBufferMemory(m_Context.device, m_Storage->buffer, m_Storage->memory, 0));
 
         VkBufferDeviceAddressInfo bufferInfo{VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO};
-        bufferInfo.buffer = m_Heap;
-        m_HeapGPUStartHandle = vkGetBufferDeviceAddress(m_Context.device, &bufferInfo);
-
-        RHINO_VKS(vkMapMemory(m_Context.device, m_Memory, 0, VK_WHOLE_SIZE, 0, &m_Mapped));
+        bufferInfo.buffer = m_Storage->buffer;
+        m_Storage->deviceAddress = vkGetBufferDeviceAddress(m_Context.device, &bufferInfo);
 
-        m_ImageViewPerDescriptor.resize(descriptorsCount);
+        RHINO_VKS(vkMapMemory(m_Context.device, m_Storage->memory, 0, VK_WHOLE_SIZE, 0, &m_Storage->mapped));
+        m_HeapGPUStartHandle = m_Storage->deviceAddress;
+        m_Mapped = m_Storage->mapped;
     }
     VkDeviceAddress VulkanDescriptorHeap::GetHeapGPUStartHandle() noexcept {
         return m_HeapGPUStartHandle;
     }
 
+    DescriptorHeapType VulkanDescriptorHeap::GetHeapType() const noexcept {
+        return m_HeapType;
+    }
+
+    VulkanDescriptorHeapStorage* VulkanDescriptorHeap::GetStorage() noexcept {
+        return m_Storage;
+    }
+
+    void VulkanDescriptorHeap::CopyDescriptors(size_t dstOffset, VulkanDescriptorHeap* srcHeap, size_t srcOffset,
+                                               size_t count) noexcept {
+        assert(m_HeapType == srcHeap->m_HeapType);
+        assert(dstOffset + count <= m_DescriptorsCount && srcOffset + count <= srcHeap->m_DescriptorsCount);
+        assert(m_DescriptorHandleIncrementSize == srcHeap->m_DescriptorHandleIncrementSize);
+
+        // Copied texture descriptors share image views with the source slots. References are taken before
+        // destination slots are invalidated, so overlapping copies within one heap keep the views alive.
+        std::vector<VulkanDescriptorImageView*> views{srcHeap->m_ImageViewPerDescriptor.begin() + srcOffset,
+                                                      srcHeap->m_ImageViewPerDescriptor.begin() + srcOffset + count};
+        for (VulkanDescriptorImageView* view : views) {
+            if (view) {
+                ++view->refCount;
+            }
+        }
+        for (size_t i = 0; i < count; ++i) {
+            InvalidateSlot(dstOffset + i);
+            m_ImageViewPerDescriptor[dstOffset + i] = views[i];
+        }
+
+        auto* dst = static_cast<uint8_t*>(m_Mapped) + dstOffset * m_DescriptorHandleIncrementSize;
+        const auto* src = static_cast<const uint8_t*>(srcHeap->m_Mapped) + srcOffset * srcHeap->m_DescriptorHandleIncrementSize;
+        memmove(dst, src, count * m_DescriptorHandleIncrementSize);
+    }
+
     void VulkanDescriptorHeap::WriteSRV(const WriteBufferDescriptorDesc& desc) noexcept {
+        assert(HeapSupportsDescriptorType(m_HeapType, m_Context, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER));
         InvalidateSlot(desc.offsetInHeap);
         auto* vulkanBuffer = INTERPRET_AS<VulkanBuffer*>(desc.buffer);
 
@@ -83,6 +144,7 @@ namespace RHINO::APIVulkan {
     }
 
     void VulkanDescriptorHeap::WriteUAV(const WriteBufferDescriptorDesc& desc) noexcept {
+        assert(HeapSupportsDescriptorType(m_HeapType, m_Context, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER));
         InvalidateSlot(desc.offsetInHeap);
         auto* vulkanBuffer = INTERPRET_AS<VulkanBuffer*>(desc.buffer);
 
@@ -101,6 +163,7 @@ namespace RHINO::APIVulkan {
     }
 
     void VulkanDescriptorHeap::WriteCBV(const WriteBufferDescriptorDesc& desc) noexcept {
+        assert(HeapSupportsDescriptorType(m_HeapType, m_Context, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER));
         InvalidateSlot(desc.offsetInHeap);
         auto* vulkanBuffer = INTERPRET_AS<VulkanBuffer*>(desc.buffer);
 
@@ -119,20 +182,9 @@ namespace RHINO::APIVulkan {
     }
 
     void VulkanDescriptorHeap::WriteSRV(const WriteTexture2DDescriptorDesc& desc) noexcept {
-        VkImageView& view = InvalidateSlot(desc.offsetInHeap);
-        auto* vulkanTexture = INTERPRET_AS<VulkanTexture2D*>(desc.texture);
-
-        VkImageViewCreateInfo viewInfo{VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO};
-        viewInfo.flags = 0;
-        viewInfo.format = vulkanTexture->origimalFormat;
-        viewInfo.image = vulkanTexture->texture;
-        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-        viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        viewInfo.subresourceRange.baseArrayLayer = 0;
-        viewInfo.subresourceRange.layerCount = VK_WHOLE_SIZE;
-        viewInfo.subresourceRange.baseMipLevel = 0;
-        viewInfo.subresourceRange.levelCount = VK_WHOLE_SIZE;
-        RHINO_VKS(vkCreateImageView(m_Context.device, &viewInfo, m_Context.allocator, &view));
+        assert(HeapSupportsDescriptorType(m_HeapType, m_Context, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE));
+        InvalidateSlot(desc.offsetInHeap);
+        VkImageView view = CreateSlotImageView(desc.offsetInHeap, INTERPRET_AS<VulkanTexture2D*>(desc.texture));
 
         VkDescriptorImageInfo textureInfo{};
         textureInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
@@ -148,20 +200,9 @@ namespace RHINO::APIVulkan {
     }
 
     void VulkanDescriptorHeap::WriteUAV(const WriteTexture2DDescriptorDesc& desc) noexcept {
-        VkImageView& view = InvalidateSlot(desc.offsetInHeap);
-        auto* vulkanTexture = INTERPRET_AS<VulkanTexture2D*>(desc.texture);
-
-        VkImageViewCreateInfo viewInfo{VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO};
-        viewInfo.flags = 0;
-        viewInfo.format = vulkanTexture->origimalFormat;
-        viewInfo.image = vulkanTexture->texture;
-        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-        viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        viewInfo.subresourceRange.baseArrayLayer = 0;
-        viewInfo.subresourceRange.layerCount = VK_WHOLE_SIZE;
-        viewInfo.subresourceRange.baseMipLevel = 0;
-        viewInfo.subresourceRange.levelCount = VK_WHOLE_SIZE;
-        RHINO_VKS(vkCreateImageView(m_Context.device, &viewInfo, m_Context.allocator, &view));
+        assert(HeapSupportsDescriptorType(m_HeapType, m_Context, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE));
+        InvalidateSlot(desc.offsetInHeap);
+        VkImageView view = CreateSlotImageView(desc.offsetInHeap, INTERPRET_AS<VulkanTexture2D*>(desc.texture));
 
         VkDescriptorImageInfo textureInfo{};
         textureInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
@@ -187,38 +228,61 @@ namespace RHINO::APIVulkan {
     }
 
     void VulkanDescriptorHeap::WriteSRV(const WriteTLASDescriptorDesc& desc) noexcept {
+        assert(HeapSupportsDescriptorType(m_HeapType, m_Context, VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR));
         InvalidateSlot(desc.offsetInHeap);
-        // TODO: implement
+        auto* vulkanTLAS = INTERPRET_AS<VulkanTLAS*>(desc.tlas);
+
+        VkDescriptorGetInfoEXT info{VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT};
+        info.type = VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR;
+        info.data.accelerationStructure = vulkanTLAS->deviceAddress;
+
+        auto* mem = static_cast<uint8_t*>(m_Mapped);
+        EXT::vkGetDescriptorEXT(m_Context.device, &info, m_DescriptorProps.accelerationStructureDescriptorSize,
+                                mem + desc.offsetInHeap * m_DescriptorHandleIncrementSize);
     }
 
     void VulkanDescriptorHeap::WriteSMP(Sampler* sampler, size_t offsetInHeap) noexcept {
+        assert(HeapSupportsDescriptorType(m_HeapType, m_Context, VK_DESCRIPTOR_TYPE_SAMPLER));
         auto* vulkanSampler = INTERPRET_AS<VulkanSampler*>(sampler);
 
-        VkDescriptorGetInfoEXT info{VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT};
-        info.type = VK_DESCRIPTOR_TYPE_SAMPLER;
-        info.data.pSampler = &vulkanSampler->sampler;
-
         auto* mem = static_cast<uint8_t*>(m_Mapped);
-        EXT::vkGetDescriptorEXT(m_Context.device, &info, m_DescriptorProps.samplerDescriptorSize,
-                                mem + offsetInHeap * m_DescriptorHandleIncrementSize);
+        memcpy(mem + offsetInHeap * m_DescriptorHandleIncrementSize, vulkanSampler->descriptor.data(), vulkanSampler->descriptor.size());
     }
 
     void VulkanDescriptorHeap::Release() noexcept {
-        for (VkImageView view : m_ImageViewPerDescriptor) {
-            vkDestroyImageView(m_Context.device, view, m_Context.allocator);
+        for (size_t i = 0; i < m_ImageViewPerDescriptor.size(); ++i) {
+            InvalidateSlot(i);
         }
-        vkUnmapMemory(m_Context.device, this->m_Memory);
-        vkDestroyBuffer(m_Context.device, this->m_Heap, m_Context.allocator);
-        vkFreeMemory(m_Context.device, this->m_Memory, m_Context.allocator);
+        m_Storage->Release();
         delete this;
     }
 
-    VkImageView& VulkanDescriptorHeap::InvalidateSlot(uint32_t descriptorSlot) noexcept {
+    void VulkanDescriptorHeap::InvalidateSlot(size_t descriptorSlot) noexcept {
+        // Submitted work may still read the old descriptor, so the view is destroyed through the garbage collector.
         if (m_ImageViewPerDescriptor[descriptorSlot]) {
-            vkDestroyImageView(m_Context.device, m_ImageViewPerDescriptor[descriptorSlot], m_Context.allocator);
+            m_ImageViewPerDescriptor[descriptorSlot]->Release();
         }
-        m_ImageViewPerDescriptor[descriptorSlot] = VK_NULL_HANDLE;
-        return m_ImageViewPerDescriptor[descriptorSlot];
+        m_ImageViewPerDescriptor[descriptorSlot] = nullptr;
+    }
+
+    VkImageView VulkanDescriptorHeap::CreateSlotImageView(size_t descriptorSlot, VulkanTexture2D* texture) noexcept {
+        VkImageViewCreateInfo viewInfo{VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO};
+        viewInfo.flags = 0;
+        viewInfo.format = texture->origimalFormat;
+        viewInfo.image = texture->texture;
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        viewInfo.subresourceRange.baseArrayLayer = 0;
+        viewInfo.subresourceRange.layerCount = VK_WHOLE_SIZE;
+        viewInfo.subresourceRange.baseMipLevel = 0;
+        viewInfo.subresourceRange.levelCount = VK_WHOLE_SIZE;
+
+        auto* slotView = new VulkanDescriptorImageView{};
+        slotView->refCount = 1;
+        slotView->garbageCollector = m_GarbageCollector;
+        RHINO_VKS(vkCreateImageView(m_Context.device, &viewInfo, m_Context.allocator, &slotView->view));
+        m_ImageViewPerDescriptor[descriptorSlot] = slotView;
+        return slotView->view;
     }
 } // namespace RHINO::APIVulkan
 
@@ -3,22 +3,80 @@
 #ifdef ENABLE_API_VULKAN
 
 #include "VulkanBackendTypes.h"
+#include "VulkanGarbageCollector.h"
 
 namespace RHINO::APIVulkan {
+    /**
+     * Image view referenced by texture descriptors. Slots holding copies of one descriptor share the view,
+     * it is destroyed through the garbage collector when the last of them is rewritten or released.
+     */
+    class VulkanDescriptorImageView {
+    public:
+        VkImageView view = VK_NULL_HANDLE;
+        std::atomic<uint32_t> refCount = 0;
+        VulkanGarbageCollector* garbageCollector = nullptr;
+
+    public:
+        void Release() noexcept {
+            if (--this->refCount == 0) {
+                this->garbageCollector->AddGarbage(this->view);
+                delete this;
+            }
+        }
+    };
+
+    /**
+     * Descriptor buffer of a heap. Referenced by the heap and by command lists that bound it,
+     * so storage replaced by Grow lives until all command lists recorded with it are executed or released.
+     */
+    class VulkanDescriptorHeapStorage : public Object {
+    public:
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        void* mapped = nullptr;
+        VkDeviceAddress deviceAddress = 0;
+        std::atomic<uint32_t> refCount = 0;
+        VulkanObjectContext context = {};
+
+    public:
+        void AddRef() noexcept {
+            ++this->refCount;
+        }
+
+        void Release() noexcept final {
+            if (--this->refCount == 0) {
+                vkUnmapMemory(this->context.device, this->memory);
+                vkDestroyBuffer(this->context.device, this->buffer, this->context.allocator);
+                vkFreeMemory(this->context.device, this->memory, this->context.allocator);
+                delete this;
+            }
+        }
+    };
+
     class VulkanDescriptorHeap : public DescriptorHeap {
     public:
-        static constexpr VkDescriptorType CDBSRVUAVTypes[6] = {
+        // Acceleration structure type goes last, so it is dropped when device has no acceleration structures.
+        static constexpr VkDescriptorType CDBSRVUAVTypes[7] = {
                 VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,        VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,  VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER,
-                VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER};
+                VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR};
         static constexpr VkDescriptorType CBVTypes[1] = {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER};
         static constexpr VkDescriptorType SRVTypes[3] = {VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
                                                          VK_DESCRIPTOR_TYPE_STORAGE_BUFFER};
         static constexpr VkDescriptorType UAVTypes[3] = {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER,
                                                          VK_DESCRIPTOR_TYPE_STORAGE_BUFFER};
+        static constexpr VkDescriptorType BuffersOnlyTypes[3] = {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                                                                 VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR};
+        static constexpr VkDescriptorType TexturesOnlyTypes[2] = {VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE};
+        static constexpr VkDescriptorType SamplerTypes[1] = {VK_DESCRIPTOR_TYPE_SAMPLER};
 
     public:
-        void Initialize(const char* name, DescriptorHeapType type, size_t descriptorsCount, VulkanObjectContext context) noexcept;
+        void Initialize(const char* name, DescriptorHeapType type, size_t descriptorsCount, VulkanObjectContext context,
+                        VulkanGarbageCollector* garbageCollector) noexcept;
         VkDeviceAddress GetHeapGPUStartHandle() noexcept;
+        DescriptorHeapType GetHeapType() const noexcept;
+        VulkanDescriptorHeapStorage* GetStorage() noexcept;
+        void CopyDescriptors(size_t dstOffset, VulkanDescriptorHeap* srcHeap, size_t srcOffset, size_t count) noexcept;
 
     public:
         void WriteSRV(const WriteBufferDescriptorDesc& desc) noexcept final;
@@ -30,25 +88,32 @@ namespace RHINO::APIVulkan {
         void WriteUAV(const WriteTexture3DDescriptorDesc& desc) noexcept final;
         void WriteSRV(const WriteTLASDescriptorDesc& desc) noexcept final;
         void WriteSMP(Sampler* sampler, size_t offsetInHeap) noexcept final;
+        void Grow(size_t newDescriptorsCount) noexcept final;
 
     public:
         void Release() noexcept final;
 
     private:
-        VkImageView& InvalidateSlot(uint32_t descriptorSlot) noexcept;
+        void AllocateHeapStorage(size_t descriptorsCount) noexcept;
+        void InvalidateSlot(size_t descriptorSlot) noexcept;
+        // Creates view of the whole 2D texture owned by the slot.
+        VkImageView CreateSlotImageView(size_t descriptorSlot, VulkanTexture2D* texture) noexcept;
 
     private:
+        DescriptorHeapType m_HeapType = DescriptorHeapType::SRV_CBV_UAV;
+        size_t m_DescriptorsCount = 0;
         uint32_t m_HeapSize = 0;
-        VkBuffer m_Heap = VK_NULL_HANDLE;
-        VkDeviceMemory m_Memory = VK_NULL_HANDLE;
+        VulkanDescriptorHeapStorage* m_Storage = nullptr;
         void* m_Mapped = nullptr;
         VkDeviceAddress m_HeapGPUStartHandle = 0;
         size_t m_DescriptorHandleIncrementSize = 0;
+        VkDeviceSize m_HeapPadding = 0;
 
         VkPhysicalDeviceDescriptorBufferPropertiesEXT m_DescriptorProps{};
         VulkanObjectContext m_Context = {};
+        VulkanGarbageCollector* m_GarbageCollector = nullptr;
 
-        std::vector<VkImageView> m_ImageViewPerDescriptor{};
+        std::vector<VulkanDescriptorImageView*> m_ImageViewPerDescriptor{};
     };
 
 } // namespace RHINO::APIVulkan
@@ -0,0 +1,88 @@
+#ifdef ENABLE_API_VULKAN
+
+#include "VulkanGarbageCollector.h"
+
+namespace RHINO::APIVulkan {
+    void VulkanGarbageCollector::Initialize(const VulkanObjectContext& context) noexcept {
+        m_Context = context;
+
+        VkSemaphoreTypeCreateInfo timelineCreateInfo{VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO};
+        timelineCreateInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        timelineCreateInfo.initialValue = 0;
+
+        VkSemaphoreCreateInfo createInfo{VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
+        createInfo.pNext = &timelineCreateInfo;
+        RHINO_VKS(vkCreateSemaphore(m_Context.device, &createInfo, m_Context.allocator, &m_SubmissionSemaphore));
+    }
+
+    void VulkanGarbageCollector::AddGarbage(Object* object) noexcept {
+        std::lock_guard lock{m_Mutex};
+        m_TrackedItems.emplace_back(VK_NULL_HANDLE, object, m_LastSubmissionValue);
+    }
+
+    void VulkanGarbageCollector::AddGarbage(VkImageView imageView) noexcept {
+        std::lock_guard lock{m_Mutex};
+        m_TrackedItems.emplace_back(imageView, nullptr, m_LastSubmissionValue);
+    }
+
+    void VulkanGarbageCollector::Submit(VkQueue queue, VkCommandBuffer cmd, std::vector<Object*>& retiredObjects) noexcept {
+        // Submitted under lock, so the semaphore is signaled with increasing values in queue order.
+        std::lock_guard lock{m_Mutex};
+        const uint64_t signalValue = m_LastSubmissionValue + 1;
+
+        VkTimelineSemaphoreSubmitInfo timelineInfo{VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO};
+        timelineInfo.signalSemaphoreValueCount = 1;
+        timelineInfo.pSignalSemaphoreValues = &signalValue;
+
+        VkSubmitInfo submitInfo{VK_STRUCTURE_TYPE_SUBMIT_INFO};
+        submitInfo.pNext = &timelineInfo;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &cmd;
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores = &m_SubmissionSemaphore;
+        RHINO_VKS(vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE));
+        m_LastSubmissionValue = signalValue;
+
+        for (Object* object : retiredObjects) {
+            m_TrackedItems.emplace_back(VK_NULL_HANDLE, object, signalValue);
+        }
+        retiredObjects.clear();
+    }
+
+    void VulkanGarbageCollector::CollectGarbage() noexcept {
+        std::lock_guard lock{m_Mutex};
+        uint64_t completedValue = 0;
+        RHINO_VKS(vkGetSemaphoreCounterValue(m_Context.device, m_SubmissionSemaphore, &completedValue));
+
+        auto i = m_TrackedItems.begin();
+        while (i != m_TrackedItems.end()) {
+            if (i->completionValue <= completedValue) {
+                ReleaseGarbage(*i);
+                i = m_TrackedItems.erase(i);
+            }
+            else {
+                ++i;
+            }
+        }
+    }
+
+    void VulkanGarbageCollector::Release() noexcept {
+        std::lock_guard lock{m_Mutex};
+        RHINO_VKS(vkDeviceWaitIdle(m_Context.device));
+        for (auto& item : m_TrackedItems) {
+            ReleaseGarbage(item);
+        }
+        m_TrackedItems.clear();
+        vkDestroySemaphore(m_Context.device, m_SubmissionSemaphore, m_Context.allocator);
+    }
+
+    void VulkanGarbageCollector::ReleaseGarbage(const Garbage& garbage) noexcept {
+        if (garbage.object) {
+            garbage.object->Release();
+            return;
+        }
+        vkDestroyImageView(m_Context.device, garbage.imageView, m_Context.allocator);
+    }
+} // namespace RHINO::APIVulkan
+
+#endif // ENABLE_API_VULKAN
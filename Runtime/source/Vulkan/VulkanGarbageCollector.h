@@ -0,0 +1,39 @@
+#pragma once
+
+#ifdef ENABLE_API_VULKAN
+
+#include "VulkanBackendTypes.h"
+
+namespace RHINO::APIVulkan {
+    class VulkanGarbageCollector {
+    private:
+        struct Garbage {
+            VkImageView imageView;
+            Object* object;
+            uint64_t completionValue;
+        };
+
+    public:
+        void Initialize(const VulkanObjectContext& context) noexcept;
+        // Releases object by Object::Release after all work already submitted with Submit is complete.
+        void AddGarbage(Object* object) noexcept;
+        // Same for image views.
+        void AddGarbage(VkImageView imageView) noexcept;
+        // Submits command buffer to the tracked queue and releases retiredObjects after it is executed. Clears retiredObjects.
+        void Submit(VkQueue queue, VkCommandBuffer cmd, std::vector<Object*>& retiredObjects) noexcept;
+        void CollectGarbage() noexcept;
+        void Release() noexcept;
+
+    private:
+        void ReleaseGarbage(const Garbage& garbage) noexcept;
+
+    private:
+        VulkanObjectContext m_Context = {};
+        std::mutex m_Mutex{};
+        std::list<Garbage> m_TrackedItems{};
+        VkSemaphore m_SubmissionSemaphore = VK_NULL_HANDLE;
+        uint64_t m_LastSubmissionValue = 0;
+    };
+} // namespace RHINO::APIVulkan
+
+#endif // ENABLE_API_VULKAN
@@ -0,0 +1,117 @@
+#ifdef ENABLE_API_VULKAN
+
+#include "VulkanPipelineCache.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace RHINO::APIVulkan {
+    void VulkanPipelineCache::Initialize(const VulkanObjectContext& context, const char* path) noexcept {
+        m_Context = context;
+        m_Path = path ? path : "";
+
+        std::vector<uint8_t> initialData = LoadValidatedData();
+
+        VkPipelineCacheCreateInfo createInfo{VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
+        createInfo.initialDataSize = initialData.size();
+        createInfo.pInitialData = initialData.empty() ? nullptr : initialData.data();
+        RHINO_VKS(vkCreatePipelineCache(m_Context.device, &createInfo, m_Context.allocator, &m_PipelineCache));
+    }
+
+    bool VulkanPipelineCache::Save() noexcept {
+        if (m_Path.empty()) {
+            return false;
+        }
+
+        size_t dataSize = 0;
+        RHINO_VKS(vkGetPipelineCacheData(m_Context.device, m_PipelineCache, &dataSize, nullptr));
+        std::vector<uint8_t> data{};
+        data.resize(dataSize);
+        RHINO_VKS(vkGetPipelineCacheData(m_Context.device, m_PipelineCache, &dataSize, data.data()));
+
+        FileHeader header = MakeFileHeader();
+        header.dataSize = dataSize;
+
+        // Write to temporary file and swap it with the old one, so a crash never leaves a partially written cache behind.
+        const std::string tempPath = m_Path + ".tmp";
+        {
+            std::ofstream file{tempPath, std::ios::binary | std::ios::trunc};
+            if (!file) {
+                return false;
+            }
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(dataSize));
+            if (!file) {
+                return false;
+            }
+        }
+
+        std::error_code error{};
+        std::filesystem::rename(tempPath, m_Path, error);
+        return !error;
+    }
+
+    void VulkanPipelineCache::Release() noexcept {
+        Save();
+        vkDestroyPipelineCache(m_Context.device, m_PipelineCache, m_Context.allocator);
+        m_PipelineCache = VK_NULL_HANDLE;
+    }
+
+    VkPipelineCache VulkanPipelineCache::GetPipelineCache() const noexcept {
+        return m_PipelineCache;
+    }
+
+    std::vector<uint8_t> VulkanPipelineCache::LoadValidatedData() const noexcept {
+        if (m_Path.empty()) {
+            return {};
+        }
+
+        std::ifstream file{m_Path, std::ios::binary | std::ios::ate};
+        if (!file) {
+            return {};
+        }
+        const std::streamoff fileSize = file.tellg();
+        file.seekg(0, std::ios::beg);
+
+        FileHeader header{};
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!file) {
+            return {};
+        }
+
+        const FileHeader expected = MakeFileHeader();
+        if (header.magic != expected.magic || header.vendorID != expected.vendorID || header.deviceID != expected.deviceID ||
+            header.driverVersion != expected.driverVersion ||
+            memcmp(header.pipelineCacheUUID, expected.pipelineCacheUUID, VK_UUID_SIZE) != 0) {
+            return {};
+        }
+
+        // Truncated or corrupted file may declare any size, so it is checked before allocation.
+        const std::streamoff dataSizeInFile = fileSize - static_cast<std::streamoff>(sizeof(header));
+        if (fileSize < 0 || header.dataSize > static_cast<uint64_t>(dataSizeInFile)) {
+            return {};
+        }
+
+        std::vector<uint8_t> result{};
+        result.resize(header.dataSize);
+        file.read(reinterpret_cast<char*>(result.data()), static_cast<std::streamsize>(header.dataSize));
+        if (!file || file.gcount() != static_cast<std::streamsize>(header.dataSize)) {
+            return {};
+        }
+        return result;
+    }
+
+    VulkanPipelineCache::FileHeader VulkanPipelineCache::MakeFileHeader() const noexcept {
+        VkPhysicalDeviceProperties props{};
+        vkGetPhysicalDeviceProperties(m_Context.physicalDevice, &props);
+
+        FileHeader result{};
+        result.vendorID = props.vendorID;
+        result.deviceID = props.deviceID;
+        result.driverVersion = props.driverVersion;
+        memcpy(result.pipelineCacheUUID, props.pipelineCacheUUID, VK_UUID_SIZE);
+        return result;
+    }
+} // namespace RHINO::APIVulkan
+
+#endif // ENABLE_API_VULKAN
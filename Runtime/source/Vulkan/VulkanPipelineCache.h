@@ -0,0 +1,42 @@
+#pragma once
+
+#ifdef ENABLE_API_VULKAN
+
+#include "VulkanBackendTypes.h"
+
+namespace RHINO::APIVulkan {
+    /**
+     * Backend owned VkPipelineCache persisted to disk.
+     * Cache file is discarded if it was produced by other device, vendor or driver version.
+     */
+    class VulkanPipelineCache {
+    private:
+        static constexpr uint32_t FileMagic = 0x4F4E4952; // "RINO"
+
+        struct FileHeader {
+            uint32_t magic = FileMagic;
+            uint32_t vendorID = 0;
+            uint32_t deviceID = 0;
+            uint32_t driverVersion = 0;
+            uint8_t pipelineCacheUUID[VK_UUID_SIZE] = {};
+            uint64_t dataSize = 0;
+        };
+
+    public:
+        void Initialize(const VulkanObjectContext& context, const char* path) noexcept;
+        bool Save() noexcept;
+        void Release() noexcept;
+        VkPipelineCache GetPipelineCache() const noexcept;
+
+    private:
+        std::vector<uint8_t> LoadValidatedData() const noexcept;
+        FileHeader MakeFileHeader() const noexcept;
+
+    private:
+        VulkanObjectContext m_Context = {};
+        VkPipelineCache m_PipelineCache = VK_NULL_HANDLE;
+        std::string m_Path{};
+    };
+} // namespace RHINO::APIVulkan
+
+#endif // ENABLE_API_VULKAN
@@ -0,0 +1,158 @@
+#ifdef ENABLE_API_VULKAN
+
+#include "VulkanRootSignatureCache.h"
+#include "VulkanAPI.h"
+#include "VulkanUtils.h"
+
+namespace RHINO::APIVulkan {
+    void VulkanRootSignature::AddRef() noexcept {
+        cache->AddRefRootSignature(this);
+    }
+
+    void VulkanRootSignature::Release() noexcept {
+        cache->ReleaseRootSignature(this);
+    }
+
+    size_t VulkanRootSignatureCache::RootSignatureKeyHash::operator()(const RootSignatureKey& key) const noexcept {
+        size_t result = 0;
+        for (size_t value : key) {
+            HashCombine(result, value);
+        }
+        return result;
+    }
+
+    void VulkanRootSignatureCache::Initialize(const VulkanObjectContext& context) noexcept {
+        m_Context = context;
+    }
+
+    VulkanRootSignature* VulkanRootSignatureCache::AcquireRootSignature(const RootSignatureDesc& desc) noexcept {
+        RootSignatureKey key = MakeRootSignatureKey(desc);
+
+        std::lock_guard lock{m_Mutex};
+        auto cached = m_RootSignatures.find(key);
+        if (cached != m_RootSignatures.end()) {
+            ++cached->second->refCount;
+            return cached->second;
+        }
+
+        VulkanRootSignature* result = CreateRootSignature(desc);
+        result->refCount = 1;
+        result->cache = this;
+        result->cacheKey = key;
+        m_RootSignatures.emplace(std::move(key), result);
+        return result;
+    }
+
+    void VulkanRootSignatureCache::AddRefRootSignature(VulkanRootSignature* rootSignature) noexcept {
+        std::lock_guard lock{m_Mutex};
+        assert(rootSignature->refCount > 0);
+        ++rootSignature->refCount;
+    }
+
+    void VulkanRootSignatureCache::ReleaseRootSignature(VulkanRootSignature* rootSignature) noexcept {
+        std::lock_guard lock{m_Mutex};
+        assert(rootSignature->refCount > 0);
+        if (--rootSignature->refCount > 0) {
+            return;
+        }
+
+        m_RootSignatures.erase(rootSignature->cacheKey);
+        vkDestroyPipelineLayout(m_Context.device, rootSignature->layout, m_Context.allocator);
+        delete rootSignature;
+    }
+
+    void VulkanRootSignatureCache::Release() noexcept {
+        std::lock_guard lock{m_Mutex};
+        for (auto& [key, rootSignature] : m_RootSignatures) {
+            vkDestroyPipelineLayout(m_Context.device, rootSignature->layout, m_Context.allocator);
+            delete rootSignature;
+        }
+        m_RootSignatures.clear();
+
+        for (auto [layoutKey, layout] : m_SpaceLayouts) {
+            vkDestroyDescriptorSetLayout(m_Context.device, layout, m_Context.allocator);
+        }
+        m_SpaceLayouts.clear();
+    }
+
+    VulkanRootSignature* VulkanRootSignatureCache::CreateRootSignature(const RootSignatureDesc& desc) noexcept {
+        auto result = new VulkanRootSignature{};
+        result->context = m_Context;
+
+        std::map<size_t, size_t> highestBindingPerSpace{};
+        for (size_t spaceIdx = 0; spaceIdx < desc.spacesCount; ++spaceIdx) {
+            for (size_t i = 0; i < desc.spacesDescs[spaceIdx].rangeDescCount; ++i) {
+                const DescriptorRangeDesc& range = desc.spacesDescs[spaceIdx].rangeDescs[i];
+                const size_t binding = range.baseRegisterSlot + range.descriptorsCount;
+                if (highestBindingPerSpace.contains(spaceIdx)) {
+                    highestBindingPerSpace[spaceIdx] = std::max(highestBindingPerSpace[spaceIdx], binding);
+                } else {
+                    highestBindingPerSpace[spaceIdx] = binding;
+                }
+            }
+        }
+
+        std::vector<VkDescriptorSetLayout> spaceLayouts{};
+        spaceLayouts.resize(desc.spacesCount);
+        for (size_t spaceIdx = 0; spaceIdx < desc.spacesCount; ++spaceIdx) {
+            const DescriptorSpaceDesc& spaceDesc = desc.spacesDescs[spaceIdx];
+
+            const auto heapOffsetInDescriptors = std::make_pair(spaceDesc.spaceType, spaceDesc.offsetInDescriptorsFromTableStart);
+            result->heapOffsetsInDescriptorsBySpace[spaceIdx] = heapOffsetInDescriptors;
+
+            const size_t bindingsCount = highestBindingPerSpace[spaceIdx] + 1;
+            spaceLayouts[spaceIdx] = AcquireSpaceLayout(spaceDesc.spaceType, bindingsCount);
+
+#ifdef RHINO_VULKAN_PRINT_DESCRIPTOR_LAYOUTS
+            VkDeviceSize debugSize = 0;
+            EXT::vkGetDescriptorSetLayoutSizeEXT(m_Context.device, spaceLayouts[spaceIdx], &debugSize);
+            std::cout << "Set " << spaceIdx << " size: " << debugSize << "\n";
+            for (size_t bnd = 0; bnd < bindingsCount; ++bnd) {
+                VkDeviceSize debugOffset = 0;
+                EXT::vkGetDescriptorSetLayoutBindingOffsetEXT(m_Context.device, spaceLayouts[spaceIdx], bnd, &debugOffset);
+                std::cout << "  Binding " << bnd << " off: " << debugOffset << std::endl;
+            }
+#endif // RHINO_VULKAN_PRINT_DESCRIPTOR_LAYOUTS
+        }
+
+        VkPipelineLayoutCreateInfo layoutInfo{VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO};
+        layoutInfo.pushConstantRangeCount = 0;
+        layoutInfo.setLayoutCount = spaceLayouts.size();
+        layoutInfo.pSetLayouts = spaceLayouts.data();
+        RHINO_VKS(vkCreatePipelineLayout(m_Context.device, &layoutInfo, m_Context.allocator, &result->layout));
+        return result;
+    }
+
+    VkDescriptorSetLayout VulkanRootSignatureCache::AcquireSpaceLayout(DescriptorHeapType heapType, size_t bindingsCount) noexcept {
+        const auto layoutKey = std::make_pair(heapType, bindingsCount);
+        auto cached = m_SpaceLayouts.find(layoutKey);
+        if (cached != m_SpaceLayouts.end()) {
+            return cached->second;
+        }
+
+        VkDescriptorSetLayout layout = CreateSpaceDescriptorSetLayout(heapType, bindingsCount, m_Context);
+        m_SpaceLayouts[layoutKey] = layout;
+        return layout;
+    }
+
+    VulkanRootSignatureCache::RootSignatureKey VulkanRootSignatureCache::MakeRootSignatureKey(const RootSignatureDesc& desc) noexcept {
+        RootSignatureKey result{};
+        result.push_back(desc.spacesCount);
+        for (size_t spaceIdx = 0; spaceIdx < desc.spacesCount; ++spaceIdx) {
+            const DescriptorSpaceDesc& spaceDesc = desc.spacesDescs[spaceIdx];
+            result.push_back(static_cast<size_t>(spaceDesc.spaceType));
+            result.push_back(spaceDesc.space);
+            result.push_back(spaceDesc.offsetInDescriptorsFromTableStart);
+            result.push_back(spaceDesc.rangeDescCount);
+            for (size_t i = 0; i < spaceDesc.rangeDescCount; ++i) {
+                const DescriptorRangeDesc& range = spaceDesc.rangeDescs[i];
+                result.push_back(static_cast<size_t>(range.rangeType));
+                result.push_back(range.baseRegisterSlot);
+                result.push_back(range.descriptorsCount);
+            }
+        }
+        return result;
+    }
+} // namespace RHINO::APIVulkan
+
+#endif // ENABLE_API_VULKAN
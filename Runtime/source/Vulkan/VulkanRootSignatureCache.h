@@ -0,0 +1,42 @@
+#pragma once
+
+#ifdef ENABLE_API_VULKAN
+
+#include "VulkanBackendTypes.h"
+
+namespace RHINO::APIVulkan {
+    /**
+     * Shares root signatures between structurally identical root signature descs and descriptor set layouts between spaces
+     * with the same heap type and bindings count. Root signature debug name does not take part in matching.
+     */
+    class VulkanRootSignatureCache {
+    private:
+        using RootSignatureKey = std::vector<size_t>;
+
+        struct RootSignatureKeyHash {
+            size_t operator()(const RootSignatureKey& key) const noexcept;
+        };
+
+    public:
+        void Initialize(const VulkanObjectContext& context) noexcept;
+        VulkanRootSignature* AcquireRootSignature(const RootSignatureDesc& desc) noexcept;
+        void AddRefRootSignature(VulkanRootSignature* rootSignature) noexcept;
+        void ReleaseRootSignature(VulkanRootSignature* rootSignature) noexcept;
+        void Release() noexcept;
+
+    private:
+        VulkanRootSignature* CreateRootSignature(const RootSignatureDesc& desc) noexcept;
+        VkDescriptorSetLayout AcquireSpaceLayout(DescriptorHeapType heapType, size_t bindingsCount) noexcept;
+
+        static RootSignatureKey MakeRootSignatureKey(const RootSignatureDesc& desc) noexcept;
+
+    private:
+        VulkanObjectContext m_Context = {};
+
+        std::mutex m_Mutex{};
+        std::unordered_map<RootSignatureKey, VulkanRootSignature*, RootSignatureKeyHash> m_RootSignatures{};
+        std::map<std::pair<DescriptorHeapType, size_t>, VkDescriptorSetLayout> m_SpaceLayouts{};
+    };
+} // namespace RHINO::APIVulkan
+
+#endif // ENABLE_API_VULKAN
@@ -0,0 +1,128 @@
+#ifdef ENABLE_API_VULKAN
+
+#include "VulkanSamplerCache.h"
+#include "VulkanAPI.h"
+#include "VulkanConverters.h"
+
+namespace RHINO::APIVulkan {
+    void VulkanSampler::Release() noexcept {
+        cache->ReleaseSampler(this);
+    }
+
+    void VulkanSamplerCache::Initialize(const VulkanObjectContext& context) noexcept {
+        m_Context = context;
+
+        VkPhysicalDeviceDescriptorBufferPropertiesEXT descriptorProps{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_PROPERTIES_EXT};
+        VkPhysicalDeviceProperties2 props{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2};
+        props.pNext = &descriptorProps;
+        vkGetPhysicalDeviceProperties2(m_Context.physicalDevice, &props);
+        m_DescriptorProps = descriptorProps;
+    }
+
+    VulkanSampler* VulkanSamplerCache::AcquireSampler(const SamplerDesc& desc) noexcept {
+        const size_t descHash = HashSamplerDesc(desc);
+
+        std::lock_guard lock{m_Mutex};
+        auto [begin, end] = m_Samplers.equal_range(descHash);
+        for (auto i = begin; i != end; ++i) {
+            if (IsSameSampler(i->second->desc, desc)) {
+                ++i->second->refCount;
+                return i->second;
+            }
+        }
+
+        VulkanSampler* result = CreateSampler(desc, descHash);
+        m_Samplers.emplace(descHash, result);
+        return result;
+    }
+
+    void VulkanSamplerCache::ReleaseSampler(VulkanSampler* sampler) noexcept {
+        std::lock_guard lock{m_Mutex};
+        assert(sampler->refCount > 0);
+        if (--sampler->refCount > 0) {
+            return;
+        }
+
+        auto [begin, end] = m_Samplers.equal_range(sampler->descHash);
+        for (auto i = begin; i != end; ++i) {
+            if (i->second == sampler) {
+                m_Samplers.erase(i);
+                break;
+            }
+        }
+        DestroySampler(sampler);
+    }
+
+    void VulkanSamplerCache::Release() noexcept {
+        std::lock_guard lock{m_Mutex};
+        for (auto [descHash, sampler] : m_Samplers) {
+            DestroySampler(sampler);
+        }
+        m_Samplers.clear();
+    }
+
+    VulkanSampler* VulkanSamplerCache::CreateSampler(const SamplerDesc& desc, size_t descHash) noexcept {
+        auto* result = new VulkanSampler{};
+        result->context = m_Context;
+        result->desc = desc;
+        result->desc.name = nullptr;
+        result->descHash = descHash;
+        result->refCount = 1;
+        result->cache = this;
+
+        Convert::VulkanMinMagMipFilters filters = Convert::ToMTLMinMagMipFilter(desc.textureFilter);
+        VkSamplerCreateInfo samplerInfo{VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO};
+        samplerInfo.flags = 0;
+        samplerInfo.minFilter = filters.min;
+        samplerInfo.magFilter = filters.mag;
+        samplerInfo.mipmapMode = filters.mip;
+        samplerInfo.addressModeU = Convert::ToVkSamplerAddressMode(desc.addresU);
+        samplerInfo.addressModeV = Convert::ToVkSamplerAddressMode(desc.addresV);
+        samplerInfo.addressModeW = Convert::ToVkSamplerAddressMode(desc.addresW);
+        samplerInfo.borderColor = Convert::ToVkBorderColor(desc.borderColor);
+        samplerInfo.compareEnable = desc.comparisonFunc != ComparisonFunction::Never;
+        samplerInfo.compareOp = Convert::ToVkCompareOp(desc.comparisonFunc);
+        samplerInfo.anisotropyEnable = desc.maxAnisotropy > 1;
+        samplerInfo.maxAnisotropy = static_cast<float>(desc.maxAnisotropy);
+        samplerInfo.minLod = desc.minLOD;
+        samplerInfo.maxLod = desc.maxLOD;
+        samplerInfo.mipLodBias = 0;
+        samplerInfo.unnormalizedCoordinates = false;
+        RHINO_VKS(vkCreateSampler(m_Context.device, &samplerInfo, m_Context.allocator, &result->sampler));
+
+        VkDescriptorGetInfoEXT info{VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT};
+        info.type = VK_DESCRIPTOR_TYPE_SAMPLER;
+        info.data.pSampler = &result->sampler;
+
+        result->descriptor.resize(m_DescriptorProps.samplerDescriptorSize);
+        EXT::vkGetDescriptorEXT(m_Context.device, &info, m_DescriptorProps.samplerDescriptorSize, result->descriptor.data());
+        return result;
+    }
+
+    void VulkanSamplerCache::DestroySampler(VulkanSampler* sampler) noexcept {
+        vkDestroySampler(m_Context.device, sampler->sampler, m_Context.allocator);
+        delete sampler;
+    }
+
+    size_t VulkanSamplerCache::HashSamplerDesc(const SamplerDesc& desc) noexcept {
+        size_t result = 0;
+        HashCombine(result, desc.textureFilter);
+        HashCombine(result, desc.addresU);
+        HashCombine(result, desc.addresV);
+        HashCombine(result, desc.addresW);
+        HashCombine(result, desc.borderColor);
+        HashCombine(result, desc.comparisonFunc);
+        HashCombine(result, desc.maxAnisotropy);
+        HashCombine(result, desc.minLOD);
+        HashCombine(result, desc.maxLOD);
+        return result;
+    }
+
+    bool VulkanSamplerCache::IsSameSampler(const SamplerDesc& a, const SamplerDesc& b) noexcept {
+        return a.textureFilter == b.textureFilter && a.addresU == b.addresU && a.addresV == b.addresV && a.addresW == b.addresW &&
+               a.borderColor == b.borderColor && a.comparisonFunc == b.comparisonFunc && a.maxAnisotropy == b.maxAnisotropy &&
+               a.minLOD == b.minLOD && a.maxLOD == b.maxLOD;
+    }
+} // namespace RHINO::APIVulkan
+
+#endif // ENABLE_API_VULKAN
@@ -0,0 +1,35 @@
+#pragma once
+
+#ifdef ENABLE_API_VULKAN
+
+#include "VulkanBackendTypes.h"
+
+namespace RHINO::APIVulkan {
+    /**
+     * Shares VkSampler objects between identical sampler descs.
+     * Sampler desc name does not take part in matching. Shared sampler is destroyed when its last reference is released.
+     */
+    class VulkanSamplerCache {
+    public:
+        void Initialize(const VulkanObjectContext& context) noexcept;
+        VulkanSampler* AcquireSampler(const SamplerDesc& desc) noexcept;
+        void ReleaseSampler(VulkanSampler* sampler) noexcept;
+        void Release() noexcept;
+
+    private:
+        VulkanSampler* CreateSampler(const SamplerDesc& desc, size_t descHash) noexcept;
+        void DestroySampler(VulkanSampler* sampler) noexcept;
+
+        static size_t HashSamplerDesc(const SamplerDesc& desc) noexcept;
+        static bool IsSameSampler(const SamplerDesc& a, const SamplerDesc& b) noexcept;
+
+    private:
+        VulkanObjectContext m_Context = {};
+        VkPhysicalDeviceDescriptorBufferPropertiesEXT m_DescriptorProps = {};
+
+        std::mutex m_Mutex{};
+        std::unordered_multimap<size_t, VulkanSampler*> m_Samplers{};
+    };
+} // namespace RHINO::APIVulkan
+
+#endif // ENABLE_API_VULKAN
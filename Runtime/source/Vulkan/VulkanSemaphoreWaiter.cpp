@@ -0,0 +1,104 @@
+#ifdef ENABLE_API_VULKAN
+
+#include "VulkanSemaphoreWaiter.h"
+
+namespace RHINO::APIVulkan {
+    void VulkanSemaphoreWaiter::Initialize(const VulkanObjectContext& context) noexcept {
+        m_Context = context;
+
+        VkSemaphoreTypeCreateInfo timelineCreateInfo{VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO};
+        timelineCreateInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        timelineCreateInfo.initialValue = 0;
+
+        VkSemaphoreCreateInfo createInfo{VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
+        createInfo.pNext = &timelineCreateInfo;
+        RHINO_VKS(vkCreateSemaphore(m_Context.device, &createInfo, m_Context.allocator, &m_WakeSemaphore));
+
+        m_Stop = false;
+        m_Thread = std::thread{[this]() { WaiterLoop(); }};
+    }
+
+    void VulkanSemaphoreWaiter::AddCallback(VkSemaphore semaphore, uint64_t value, SemaphoreCallback callback, void* userData) noexcept {
+        std::lock_guard lock{m_Mutex};
+        m_Pending.emplace_back(semaphore, value, callback, userData);
+
+        // Signaled under lock to keep wake values monotonic between concurrent callers.
+        VkSemaphoreSignalInfo signalInfo{VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO};
+        signalInfo.semaphore = m_WakeSemaphore;
+        signalInfo.value = ++m_WakeValue;
+        vkSignalSemaphore(m_Context.device, &signalInfo);
+    }
+
+    void VulkanSemaphoreWaiter::Release() noexcept {
+        {
+            std::lock_guard lock{m_Mutex};
+            m_Stop = true;
+
+            VkSemaphoreSignalInfo signalInfo{VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO};
+            signalInfo.semaphore = m_WakeSemaphore;
+            signalInfo.value = ++m_WakeValue;
+            vkSignalSemaphore(m_Context.device, &signalInfo);
+        }
+        if (m_Thread.joinable()) {
+            m_Thread.join();
+        }
+        m_Pending.clear();
+        vkDestroySemaphore(m_Context.device, m_WakeSemaphore, m_Context.allocator);
+        m_WakeSemaphore = VK_NULL_HANDLE;
+    }
+
+    void VulkanSemaphoreWaiter::WaiterLoop() noexcept {
+        std::vector<VkSemaphore> semaphores{};
+        std::vector<uint64_t> values{};
+        std::vector<PendingCallback> ready{};
+
+        while (true) {
+            semaphores.clear();
+            values.clear();
+            {
+                std::lock_guard lock{m_Mutex};
+                if (m_Stop) {
+                    return;
+                }
+                // Wake semaphore goes first, any AddCallback after this point interrupts the wait.
+                semaphores.push_back(m_WakeSemaphore);
+                values.push_back(m_WakeValue + 1);
+                for (const PendingCallback& pending : m_Pending) {
+                    semaphores.push_back(pending.semaphore);
+                    values.push_back(pending.value);
+                }
+            }
+
+            VkSemaphoreWaitInfo waitInfo{VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO};
+            waitInfo.flags = VK_SEMAPHORE_WAIT_ANY_BIT;
+            waitInfo.semaphoreCount = static_cast<uint32_t>(semaphores.size());
+            waitInfo.pSemaphores = semaphores.data();
+            waitInfo.pValues = values.data();
+            vkWaitSemaphores(m_Context.device, &waitInfo, UINT64_MAX);
+
+            {
+                std::lock_guard lock{m_Mutex};
+                auto i = m_Pending.begin();
+                while (i != m_Pending.end()) {
+                    uint64_t completedValue = 0;
+                    vkGetSemaphoreCounterValue(m_Context.device, i->semaphore, &completedValue);
+                    if (completedValue >= i->value) {
+                        ready.push_back(*i);
+                        i = m_Pending.erase(i);
+                    }
+                    else {
+                        ++i;
+                    }
+                }
+            }
+
+            // Called outside of the lock, so callbacks are free to register new ones.
+            for (const PendingCallback& pending : ready) {
+                pending.callback(pending.userData);
+            }
+            ready.clear();
+        }
+    }
+} // namespace RHINO::APIVulkan
+
+#endif // ENABLE_API_VULKAN
@@ -0,0 +1,42 @@
+#pragma once
+
+#ifdef ENABLE_API_VULKAN
+
+#include "VulkanBackendTypes.h"
+
+namespace RHINO::APIVulkan {
+    /**
+     * Background thread calling callbacks when timeline semaphores reach requested values.
+     * Sleeps in a single vkWaitSemaphores call with ANY semantics over all pending values.
+     */
+    class VulkanSemaphoreWaiter {
+    private:
+        struct PendingCallback {
+            VkSemaphore semaphore;
+            uint64_t value;
+            SemaphoreCallback callback;
+            void* userData;
+        };
+
+    public:
+        void Initialize(const VulkanObjectContext& context) noexcept;
+        void AddCallback(VkSemaphore semaphore, uint64_t value, SemaphoreCallback callback, void* userData) noexcept;
+        // Stops waiter thread. Pending callbacks are dropped.
+        void Release() noexcept;
+
+    private:
+        void WaiterLoop() noexcept;
+
+    private:
+        VulkanObjectContext m_Context = {};
+        std::mutex m_Mutex{};
+        std::list<PendingCallback> m_Pending{};
+        // Signaled from host to interrupt the wait when pending list changes.
+        VkSemaphore m_WakeSemaphore = VK_NULL_HANDLE;
+        uint64_t m_WakeValue = 0;
+        bool m_Stop = false;
+        std::thread m_Thread{};
+    };
+} // namespace RHINO::APIVulkan
+
+#endif // ENABLE_API_VULKAN
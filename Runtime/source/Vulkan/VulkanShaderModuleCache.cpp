@@ -0,0 +1,85 @@
+#ifdef ENABLE_API_VULKAN
+
+#include "VulkanShaderModuleCache.h"
+#include "VulkanAPI.h"
+
+#include <string_view>
+
+namespace RHINO::APIVulkan {
+    void VulkanShaderModule::Release() noexcept {
+        cache->ReleaseShaderModule(this);
+    }
+
+    void VulkanShaderModuleCache::Initialize(const VulkanObjectContext& context) noexcept {
+        m_Context = context;
+    }
+
+    VulkanShaderModule* VulkanShaderModuleCache::AcquireShaderModule(const uint8_t* bytecode, size_t bytecodeSize) noexcept {
+        const size_t bytecodeHash = HashBytecode(bytecode, bytecodeSize);
+
+        std::lock_guard lock{m_Mutex};
+        auto [begin, end] = m_ShaderModules.equal_range(bytecodeHash);
+        for (auto i = begin; i != end; ++i) {
+            const std::vector<uint8_t>& cached = i->second->bytecode;
+            if (cached.size() == bytecodeSize && memcmp(cached.data(), bytecode, bytecodeSize) == 0) {
+                ++i->second->refCount;
+                return i->second;
+            }
+        }
+
+        VulkanShaderModule* result = CreateShaderModule(bytecode, bytecodeSize, bytecodeHash);
+        m_ShaderModules.emplace(bytecodeHash, result);
+        return result;
+    }
+
+    void VulkanShaderModuleCache::ReleaseShaderModule(VulkanShaderModule* shaderModule) noexcept {
+        std::lock_guard lock{m_Mutex};
+        assert(shaderModule->refCount > 0);
+        if (--shaderModule->refCount > 0) {
+            return;
+        }
+
+        auto [begin, end] = m_ShaderModules.equal_range(shaderModule->bytecodeHash);
+        for (auto i = begin; i != end; ++i) {
+            if (i->second == shaderModule) {
+                m_ShaderModules.erase(i);
+                break;
+            }
+        }
+        DestroyShaderModule(shaderModule);
+    }
+
+    void VulkanShaderModuleCache::Release() noexcept {
+        std::lock_guard lock{m_Mutex};
+        for (auto [bytecodeHash, shaderModule] : m_ShaderModules) {
+            DestroyShaderModule(shaderModule);
+        }
+        m_ShaderModules.clear();
+    }
+
+    VulkanShaderModule* VulkanShaderModuleCache::CreateShaderModule(const uint8_t* bytecode, size_t bytecodeSize,
+                                                                    size_t bytecodeHash) noexcept {
+        auto* result = new VulkanShaderModule{};
+        result->bytecode.assign(bytecode, bytecode + bytecodeSize);
+        result->bytecodeHash = bytecodeHash;
+        result->refCount = 1;
+        result->cache = this;
+
+        VkShaderModuleCreateInfo shaderModuleInfo{VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO};
+        shaderModuleInfo.codeSize = bytecodeSize;
+        shaderModuleInfo.pCode = reinterpret_cast<const uint32_t*>(result->bytecode.data());
+        RHINO_VKS(vkCreateShaderModule(m_Context.device, &shaderModuleInfo, m_Context.allocator, &result->shaderModule));
+        return result;
+    }
+
+    void VulkanShaderModuleCache::DestroyShaderModule(VulkanShaderModule* shaderModule) noexcept {
+        vkDestroyShaderModule(m_Context.device, shaderModule->shaderModule, m_Context.allocator);
+        delete shaderModule;
+    }
+
+    size_t VulkanShaderModuleCache::HashBytecode(const uint8_t* bytecode, size_t bytecodeSize) noexcept {
+        return std::hash<std::string_view>{}(std::string_view{reinterpret_cast<const char*>(bytecode), bytecodeSize});
+    }
+} // namespace RHINO::APIVulkan
+
+#endif // ENABLE_API_VULKAN
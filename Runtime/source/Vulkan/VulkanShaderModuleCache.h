@@ -0,0 +1,34 @@
+#pragma once
+
+#ifdef ENABLE_API_VULKAN
+
+#include "VulkanBackendTypes.h"
+
+namespace RHINO::APIVulkan {
+    /**
+     * Shares VkShaderModule objects between PSOs with identical bytecode.
+     * Modules are matched by bytecode hash and verified by full bytecode comparison.
+     * Shared module is destroyed when its last reference is released.
+     */
+    class VulkanShaderModuleCache {
+    public:
+        void Initialize(const VulkanObjectContext& context) noexcept;
+        VulkanShaderModule* AcquireShaderModule(const uint8_t* bytecode, size_t bytecodeSize) noexcept;
+        void ReleaseShaderModule(VulkanShaderModule* shaderModule) noexcept;
+        void Release() noexcept;
+
+    private:
+        VulkanShaderModule* CreateShaderModule(const uint8_t* bytecode, size_t bytecodeSize, size_t bytecodeHash) noexcept;
+        void DestroyShaderModule(VulkanShaderModule* shaderModule) noexcept;
+
+        static size_t HashBytecode(const uint8_t* bytecode, size_t bytecodeSize) noexcept;
+
+    private:
+        VulkanObjectContext m_Context = {};
+
+        std::mutex m_Mutex{};
+        std::unordered_multimap<size_t, VulkanShaderModule*> m_ShaderModules{};
+    };
+} // namespace RHINO::APIVulkan
+
+#endif // ENABLE_API_VULKAN
@@ -3,6 +3,7 @@
 #ifdef ENABLE_API_VULKAN
 
 #include "VulkanAPI.h"
+#include "VulkanConverters.h"
 #include "VulkanDescriptorHeap.h"
 
 namespace RHINO::APIVulkan {
@@ -30,71 +31,218 @@ namespace RHINO::APIVulkan {
         return std::numeric_limits<uint32_t>::max();
     }
 
-    inline size_t CalculateDescriptorHandleIncrementSize(DescriptorHeapType heapType, const VkPhysicalDeviceDescriptorBufferPropertiesEXT& descriptorProps) noexcept {
-        size_t typesSize = 0;
-        const VkDescriptorType* types;
-
-        static constexpr VkDescriptorType SamplerTypes[1] = {VK_DESCRIPTOR_TYPE_SAMPLER};
+    inline const VkDescriptorType* GetHeapDescriptorTypes(DescriptorHeapType heapType, const VulkanObjectContext& context,
+                                                          size_t* typesCount) noexcept {
+        // Acceleration structure type is the last one in buffer heaps and is valid only with the extension enabled.
+        const size_t asTypesCount = context.accelerationStructures ? 0 : 1;
         switch (heapType) {
-            case DescriptorHeapType::SRV_CBV_UAV: {
-                typesSize = RHINO_ARR_SIZE(VulkanDescriptorHeap::CDBSRVUAVTypes);
-                types = VulkanDescriptorHeap::CDBSRVUAVTypes;
-                break;
-            }
+            case DescriptorHeapType::SRV_CBV_UAV:
+                *typesCount = RHINO_ARR_SIZE(VulkanDescriptorHeap::CDBSRVUAVTypes) - asTypesCount;
+                return VulkanDescriptorHeap::CDBSRVUAVTypes;
+            case DescriptorHeapType::SRV_CBV_UAV_BuffersOnly:
+                *typesCount = RHINO_ARR_SIZE(VulkanDescriptorHeap::BuffersOnlyTypes) - asTypesCount;
+                return VulkanDescriptorHeap::BuffersOnlyTypes;
+            case DescriptorHeapType::SRV_UAV_TexturesOnly:
+                *typesCount = RHINO_ARR_SIZE(VulkanDescriptorHeap::TexturesOnlyTypes);
+                return VulkanDescriptorHeap::TexturesOnlyTypes;
             case DescriptorHeapType::Sampler:
-                typesSize = RHINO_ARR_SIZE(SamplerTypes);
-                types = SamplerTypes;
-                break;
+                *typesCount = RHINO_ARR_SIZE(VulkanDescriptorHeap::SamplerTypes);
+                return VulkanDescriptorHeap::SamplerTypes;
             default:
                 assert(0);
+                *typesCount = 0;
+                return nullptr;
+        }
+    }
+
+    inline bool HeapSupportsDescriptorType(DescriptorHeapType heapType, const VulkanObjectContext& context,
+                                           VkDescriptorType descriptorType) noexcept {
+        size_t typesCount = 0;
+        const VkDescriptorType* types = GetHeapDescriptorTypes(heapType, context, &typesCount);
+        return std::find(types, types + typesCount, descriptorType) != types + typesCount;
+    }
+
+    inline size_t GetDescriptorSize(VkDescriptorType type, const VkPhysicalDeviceDescriptorBufferPropertiesEXT& descriptorProps) noexcept {
+        switch (type) {
+            case VK_DESCRIPTOR_TYPE_SAMPLER:
+                return descriptorProps.samplerDescriptorSize;
+            case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+                return descriptorProps.combinedImageSamplerDescriptorSize;
+            case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+                return descriptorProps.sampledImageDescriptorSize;
+            case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+                return descriptorProps.storageImageDescriptorSize;
+            case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+                return descriptorProps.uniformTexelBufferDescriptorSize;
+            case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+                return descriptorProps.storageTexelBufferDescriptorSize;
+            case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+                return descriptorProps.uniformBufferDescriptorSize;
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+                return descriptorProps.storageBufferDescriptorSize;
+            case VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR:
+                return descriptorProps.accelerationStructureDescriptorSize;
+            default:
+                assert(0 && "Unsupported descriptor type.");
                 return 0;
         }
+    }
+
+    inline size_t CalculateDescriptorHandleIncrementSize(DescriptorHeapType heapType, const VkPhysicalDeviceDescriptorBufferPropertiesEXT& descriptorProps,
+                                                         const VulkanObjectContext& context) noexcept {
+        size_t typesSize = 0;
+        const VkDescriptorType* types = GetHeapDescriptorTypes(heapType, context, &typesSize);
 
         size_t maxDescriptorSize = 0;
         for (size_t i = 0; i < typesSize; ++i) {
-            switch (types[i]) {
-                case VK_DESCRIPTOR_TYPE_SAMPLER:
-                    assert(heapType == DescriptorHeapType::Sampler);
-                    maxDescriptorSize = std::max(maxDescriptorSize, descriptorProps.samplerDescriptorSize);
-                    break;
-                case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
-                    assert(heapType == DescriptorHeapType::SRV_CBV_UAV);
-                    maxDescriptorSize = std::max(maxDescriptorSize, descriptorProps.combinedImageSamplerDescriptorSize);
-                    break;
-                case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
-                    assert(heapType == DescriptorHeapType::SRV_CBV_UAV);
-                    maxDescriptorSize = std::max(maxDescriptorSize, descriptorProps.sampledImageDescriptorSize);
-                    break;
-                case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
-                    assert(heapType == DescriptorHeapType::SRV_CBV_UAV);
-                    maxDescriptorSize = std::max(maxDescriptorSize, descriptorProps.storageImageDescriptorSize);
-                    break;
-                case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
-                    assert(heapType == DescriptorHeapType::SRV_CBV_UAV);
-                    maxDescriptorSize = std::max(maxDescriptorSize, descriptorProps.uniformTexelBufferDescriptorSize);
-                    break;
-                case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
-                    assert(heapType == DescriptorHeapType::SRV_CBV_UAV);
-                    maxDescriptorSize = std::max(maxDescriptorSize, descriptorProps.storageTexelBufferDescriptorSize);
-                    break;
-                case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
-                    assert(heapType == DescriptorHeapType::SRV_CBV_UAV);
-                    maxDescriptorSize = std::max(maxDescriptorSize, descriptorProps.uniformBufferDescriptorSize);
-                    break;
-                case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
-                    assert(heapType == DescriptorHeapType::SRV_CBV_UAV);
-                    maxDescriptorSize = std::max(maxDescriptorSize, descriptorProps.storageBufferDescriptorSize);
-                    break;
-                case VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR:
-                    assert(heapType == DescriptorHeapType::SRV_CBV_UAV);
-                    maxDescriptorSize = std::max(maxDescriptorSize, descriptorProps.accelerationStructureDescriptorSize);
-                    break;
-                default:
-                    assert(0 && "Unsupported descriptor type.");
-            }
+            maxDescriptorSize = std::max(maxDescriptorSize, GetDescriptorSize(types[i], descriptorProps));
         }
         return maxDescriptorSize;
     }
+
+    // Root signature descriptors are visible to compute and all ray tracing stages.
+    constexpr VkShaderStageFlags DescriptorVisibleStages = VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_RAYGEN_BIT_KHR |
+                                                           VK_SHADER_STAGE_MISS_BIT_KHR | VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR |
+                                                           VK_SHADER_STAGE_ANY_HIT_BIT_KHR | VK_SHADER_STAGE_INTERSECTION_BIT_KHR;
+
+    /**
+     * Creates descriptor buffer compatible set layout for a descriptor space of the heap type.
+     * Sampler spaces use plain sampler bindings, other spaces use mutable bindings limited to the heap descriptor types.
+     */
+    inline VkDescriptorSetLayout CreateSpaceDescriptorSetLayout(DescriptorHeapType heapType, uint32_t bindingsCount,
+                                                                const VulkanObjectContext& context) noexcept {
+        const bool isSamplerSpace = heapType == DescriptorHeapType::Sampler;
+
+        std::vector<VkDescriptorSetLayoutBinding> bindings{};
+        bindings.resize(bindingsCount);
+        for (uint32_t i = 0; i < bindings.size(); ++i) {
+            const VkDescriptorType bindingType = isSamplerSpace ? VK_DESCRIPTOR_TYPE_SAMPLER : VK_DESCRIPTOR_TYPE_MUTABLE_EXT;
+            bindings[i] = VkDescriptorSetLayoutBinding{i, bindingType, 1, DescriptorVisibleStages, nullptr};
+        }
+
+        size_t typesCount = 0;
+        const VkDescriptorType* types = GetHeapDescriptorTypes(heapType, context, &typesCount);
+        VkMutableDescriptorTypeListEXT fillMutTypeList{static_cast<uint32_t>(typesCount), types};
+        std::vector<VkMutableDescriptorTypeListEXT> mutableDescriptorTypeLists{};
+        mutableDescriptorTypeLists.resize(bindings.size(), fillMutTypeList);
+
+        VkMutableDescriptorTypeCreateInfoEXT mutableDescriptorTypeCreateInfoExt{VK_STRUCTURE_TYPE_MUTABLE_DESCRIPTOR_TYPE_CREATE_INFO_EXT};
+        mutableDescriptorTypeCreateInfoExt.mutableDescriptorTypeListCount = mutableDescriptorTypeLists.size();
+        mutableDescriptorTypeCreateInfoExt.pMutableDescriptorTypeLists = mutableDescriptorTypeLists.data();
+
+        VkDescriptorSetLayoutCreateInfo setLayoutCreateInfo{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO};
+        setLayoutCreateInfo.pNext = isSamplerSpace ? nullptr : &mutableDescriptorTypeCreateInfoExt;
+        setLayoutCreateInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_DESCRIPTOR_BUFFER_BIT_EXT;
+        setLayoutCreateInfo.bindingCount = bindings.size();
+        setLayoutCreateInfo.pBindings = bindings.data();
+
+        VkDescriptorSetLayout result = VK_NULL_HANDLE;
+        RHINO_VKS(vkCreateDescriptorSetLayout(context.device, &setLayoutCreateInfo, context.allocator, &result));
+        return result;
+    }
+
+    /**
+     * Space layouts declare one binding past the highest register slot and the driver may add a tail to the layout size.
+     * Returns the size of a single binding layout of the heap type, which is enough to keep the last space of the heap in bounds.
+     */
+    inline VkDeviceSize CalculateDescriptorHeapPadding(DescriptorHeapType heapType, const VulkanObjectContext& context) noexcept {
+        VkDescriptorSetLayout probeLayout = CreateSpaceDescriptorSetLayout(heapType, 1, context);
+        VkDeviceSize layoutSize = 0;
+        EXT::vkGetDescriptorSetLayoutSizeEXT(context.device, probeLayout, &layoutSize);
+        vkDestroyDescriptorSetLayout(context.device, probeLayout, context.allocator);
+        return layoutSize;
+    }
+
+    // Acceleration structures must be placed at offsets multiple of 256 bytes in their storage buffer.
+    constexpr VkDeviceSize ASStorageOffsetAlignment = 256;
+
+    /**
+     * Triangle geometry of a BLAS. Size queries ignore addresses except transform presence,
+     * so the same geometry is used for both size queries and builds.
+     */
+    inline VkAccelerationStructureGeometryKHR GetBLASGeometry(const BLASGeometryDesc& desc) noexcept {
+        auto* indexBuffer = static_cast<VulkanBuffer*>(desc.indexBuffer);
+        auto* vertexBuffer = static_cast<VulkanBuffer*>(desc.vertexBuffer);
+        auto* transform = static_cast<VulkanBuffer*>(desc.transformBuffer);
+
+        VkAccelerationStructureGeometryKHR result{VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR};
+        result.flags = desc.opaque ? VK_GEOMETRY_OPAQUE_BIT_KHR : 0;
+        result.geometryType = VK_GEOMETRY_TYPE_TRIANGLES_KHR;
+        result.geometry.triangles.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_TRIANGLES_DATA_KHR;
+        result.geometry.triangles.indexType = indexBuffer ? Convert::ToVkIndexType(desc.indexFormat) : VK_INDEX_TYPE_NONE_KHR;
+        result.geometry.triangles.indexData.deviceAddress = indexBuffer ? indexBuffer->deviceAddress + desc.indexBufferStartOffset : 0;
+        result.geometry.triangles.vertexStride = desc.vertexStride;
+        result.geometry.triangles.vertexFormat = Convert::ToVkFormat(desc.vertexFormat);
+        result.geometry.triangles.vertexData.deviceAddress = vertexBuffer->deviceAddress + desc.vertexBufferStartOffset;
+        result.geometry.triangles.maxVertex = desc.vertexCount;
+        result.geometry.triangles.transformData.deviceAddress = transform ? transform->deviceAddress + desc.transformBufferStartOffset : 0;
+        return result;
+    }
+
+    inline uint32_t GetBLASPrimitiveCount(const BLASGeometryDesc& desc) noexcept {
+        return static_cast<uint32_t>((desc.indexBuffer ? desc.indexCount : desc.vertexCount) / 3);
+    }
+
+    inline VkAccelerationStructureBuildGeometryInfoKHR GetBLASBuildInfo(const VkAccelerationStructureGeometryKHR* geometries,
+                                                                        uint32_t geometriesCount) noexcept {
+        VkAccelerationStructureBuildGeometryInfoKHR result{VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR};
+        result.flags = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR | VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR;
+        result.mode = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
+        result.type = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
+        result.geometryCount = geometriesCount;
+        result.pGeometries = geometries;
+        return result;
+    }
+
+    inline VkAccelerationStructureBuildSizesInfoKHR GetBLASBuildSizes(const BLASDesc& desc, const VulkanObjectContext& context) noexcept {
+        std::vector<VkAccelerationStructureGeometryKHR> geometries(desc.geometriesCount);
+        std::vector<uint32_t> primitiveCounts(desc.geometriesCount);
+        for (size_t i = 0; i < desc.geometriesCount; ++i) {
+            geometries[i] = GetBLASGeometry(desc.geometries[i]);
+            primitiveCounts[i] = GetBLASPrimitiveCount(desc.geometries[i]);
+        }
+        const VkAccelerationStructureBuildGeometryInfoKHR buildInfo = GetBLASBuildInfo(geometries.data(),
+                                                                                        static_cast<uint32_t>(geometries.size()));
+
+        VkAccelerationStructureBuildSizesInfoKHR result{VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR};
+        EXT::vkGetAccelerationStructureBuildSizesKHR(context.device, VK_ACCELERATION_STRUCTURE_BUILD_TYPE_DEVICE_KHR, &buildInfo,
+                                                     primitiveCounts.data(), &result);
+        return result;
+    }
+
+    inline VkAccelerationStructureGeometryKHR GetTLASGeometry(VkDeviceAddress instancesAddress) noexcept {
+        VkAccelerationStructureGeometryKHR result{VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR};
+        result.geometryType = VK_GEOMETRY_TYPE_INSTANCES_KHR;
+        result.geometry.instances.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_INSTANCES_DATA_KHR;
+        result.geometry.instances.arrayOfPointers = VK_FALSE;
+        result.geometry.instances.data.deviceAddress = instancesAddress;
+        return result;
+    }
+
+    inline VkAccelerationStructureBuildGeometryInfoKHR GetTLASBuildInfo(const VkAccelerationStructureGeometryKHR* geometry,
+                                                                        bool allowUpdate) noexcept {
+        VkAccelerationStructureBuildGeometryInfoKHR result{VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR};
+        result.flags = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR;
+        if (allowUpdate) {
+            result.flags |= VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR;
+        }
+        result.mode = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
+        result.type = VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR;
+        result.geometryCount = 1;
+        result.pGeometries = geometry;
+        return result;
+    }
+
+    inline VkAccelerationStructureBuildSizesInfoKHR GetTLASBuildSizes(const TLASDesc& desc, const VulkanObjectContext& context) noexcept {
+        const VkAccelerationStructureGeometryKHR geometry = GetTLASGeometry(0);
+        const VkAccelerationStructureBuildGeometryInfoKHR buildInfo = GetTLASBuildInfo(&geometry, desc.allowUpdate);
+        const auto instancesCount = static_cast<uint32_t>(desc.blasInstancesCount);
+
+        VkAccelerationStructureBuildSizesInfoKHR result{VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR};
+        EXT::vkGetAccelerationStructureBuildSizesKHR(context.device, VK_ACCELERATION_STRUCTURE_BUILD_TYPE_DEVICE_KHR, &buildInfo,
+                                                     &instancesCount, &result);
+        return result;
+    }
 }
 
 #endif // ENABLE_API_VULKAN
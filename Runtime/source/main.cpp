@@ -39,7 +39,7 @@ namespace RHINO {
         }
         // const char* validationEnv = std::getenv("RHINO_ENABLE_VALIDATION");
         // if (validationEnv != nullptr && std::string{validationEnv} == "1") {
-        //     result = new DebugLayer::DebugLayer{result};
+        //     result = new DebugLayer::DebugLayer{result, backendApi};
         // }
         return result;
     }
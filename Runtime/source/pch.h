@@ -14,7 +14,10 @@
 #include "RHINOTypes.h"
 
 #include <cstdlib>
+#include <algorithm>
 #include <map>
+#include <unordered_map>
+#include <functional>
 #include <set>
 #include <vector>
 #include <string>
@@ -23,6 +26,12 @@
 
 #include <chrono>
 #include <thread>
+#include <mutex>
+#include <atomic>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
 
 #include <iostream>
 
@@ -39,6 +39,7 @@ public:
                 }
                 m_InputFilepath = shaderFilepath.string();
                 m_Settings.computeSettings.inputFilepath = m_InputFilepath.c_str();
+                m_Settings.computeSettings.inlineRayTracing = computeSettings.value("inlineRayTracing", false);
                 break;
             }
             case SCAR::ArchivePSOType::Library: {
@@ -3,7 +3,9 @@
 #include <CLI11.hpp>
 #define SCAR_RHINO_ADDONS
 #include <SCARUnarchiver.h>
+#include <algorithm>
 #include <bitset>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <ranges>
@@ -26,6 +28,10 @@ static const char* str(SCAR::RecordType recordType) noexcept {
             return "ShadersEntrypoints";
         case SCAR::RecordType::RTAttributes:
             return "RTAttributes";
+        case SCAR::RecordType::SpecializationConstants:
+            return "SpecializationConstants";
+        case SCAR::RecordType::WorkgroupSize:
+            return "WorkgroupSize";
         default:
             return "Unknown";
     }
@@ -150,5 +156,22 @@ int main(int argc, char* argv[]) {
     std::cout << "  PSO Type: " << str(reader.GetPSOType()) << std::endl;
 
     PrintTable(reader, 2);
+
+    if (reader.HasRecord(SCAR::RecordType::SpecializationConstants)) {
+        const SCAR::Record& r = reader.GetRecord(SCAR::RecordType::SpecializationConstants);
+        std::cout << "Specialization constants:" << std::endl;
+        for (size_t offset = 0; offset + sizeof(SCAR::SpecializationConstantItem) <= r.dataSize;
+             offset += sizeof(SCAR::SpecializationConstantItem)) {
+            SCAR::SpecializationConstantItem item{};
+            memcpy(&item, r.data + offset, sizeof(SCAR::SpecializationConstantItem));
+            std::cout << "  ID: " << item.constantID << " Default: " << item.defaultValue << std::endl;
+        }
+    }
+    if (reader.HasRecord(SCAR::RecordType::WorkgroupSize)) {
+        const SCAR::Record& r = reader.GetRecord(SCAR::RecordType::WorkgroupSize);
+        uint32_t workgroupSize[3] = {};
+        memcpy(workgroupSize, r.data, std::min<size_t>(r.dataSize, sizeof(workgroupSize)));
+        std::cout << "Workgroup size: " << workgroupSize[0] << " " << workgroupSize[1] << " " << workgroupSize[2] << std::endl;
+    }
     std::cout << "\n";
 }
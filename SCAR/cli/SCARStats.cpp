@@ -0,0 +1,132 @@
+#include <RHINO.h>
+
+#include <CLI11.hpp>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+static bool ReadArchive(const std::filesystem::path& filepath, std::vector<uint8_t>& archive) noexcept {
+    std::ifstream inFile{filepath, std::ifstream::binary | std::ifstream::ate};
+    if (!inFile.is_open()) {
+        return false;
+    }
+    std::streamsize size = inFile.tellg();
+    inFile.seekg(0, std::ifstream::beg);
+    archive.resize(size);
+    return size && inFile.read(reinterpret_cast<char*>(archive.data()), size);
+}
+
+static bool ParseSpace(const std::string& str, RHINO::DescriptorSpaceDesc& space, RHINO::DescriptorRangeDesc& range) noexcept {
+    const size_t separator = str.find(':');
+    if (separator == std::string::npos) {
+        return false;
+    }
+    const std::string type = str.substr(0, separator);
+    if (type == "SRV_CBV_UAV") {
+        space.spaceType = RHINO::DescriptorHeapType::SRV_CBV_UAV;
+        range.rangeType = RHINO::DescriptorRangeType::CBV;
+    } else if (type == "Sampler") {
+        space.spaceType = RHINO::DescriptorHeapType::Sampler;
+        range.rangeType = RHINO::DescriptorRangeType::Sampler;
+    } else {
+        return false;
+    }
+    const char* countBegin = str.data() + separator + 1;
+    const char* countEnd = str.data() + str.size();
+    size_t descriptorsCount = 0;
+    const auto [parsedEnd, error] = std::from_chars(countBegin, countEnd, descriptorsCount);
+    if (error != std::errc{} || parsedEnd != countEnd) {
+        return false;
+    }
+    range.baseRegisterSlot = 0;
+    range.descriptorsCount = descriptorsCount;
+    return true;
+}
+
+static void PrintStatistics(const RHINO::PSOStatistics& stats) noexcept {
+    std::cout << "  Vector registers: " << stats.vectorRegistersCount << std::endl;
+    std::cout << "  Scalar registers: " << stats.scalarRegistersCount << std::endl;
+    std::cout << "  Spills: " << stats.spillsCount << std::endl;
+    std::cout << "  Shared memory: " << stats.sharedMemorySizeInBytes << std::endl;
+    std::cout << "  Subgroup size: " << stats.subgroupSize << std::endl;
+    std::cout << "  Driver statistics:" << std::endl;
+    for (size_t i = 0; i < stats.statisticsCount; ++i) {
+        std::cout << "    " << stats.statistics[i].name << ": " << stats.statistics[i].value << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::filesystem::path> archiveFilepaths;
+    std::vector<std::string> spacesS{"SRV_CBV_UAV:64"};
+
+    CLI::App app{"RHINO Shader Compiler-Archiver PSO statistics utility. Compiles compute archives with Vulkan backend.", "SCARStats"};
+    try {
+        app.add_option("filepaths", archiveFilepaths, "SCAR compute archive filepaths")->required();
+        app.add_option("-s,--space", spacesS, "Root signature space as <SRV_CBV_UAV|Sampler>:<descriptorsCount>. One per shader space.");
+        app.parse(argc, argv);
+    }
+    catch (std::exception& error) {
+        std::cerr << "SCARStats CLI usage error:\n" << error.what() << std::endl;
+        return 1;
+    }
+
+    std::vector<RHINO::DescriptorSpaceDesc> spaces(spacesS.size());
+    std::vector<RHINO::DescriptorRangeDesc> ranges(spacesS.size());
+    for (size_t i = 0; i < spacesS.size(); ++i) {
+        if (!ParseSpace(spacesS[i], spaces[i], ranges[i])) {
+            std::cerr << "Invalid space: " << spacesS[i] << std::endl;
+            return 1;
+        }
+        spaces[i].space = i;
+        spaces[i].rangeDescCount = 1;
+        spaces[i].rangeDescs = &ranges[i];
+    }
+
+    RHINO::RHINOInterface* rhi = RHINO::CreateRHINO(RHINO::BackendAPI::Vulkan);
+    RHINO::InitializeDesc initDesc{};
+    initDesc.capturePSOStatistics = true;
+    rhi->Initialize(initDesc);
+
+    RHINO::RootSignatureDesc rootSignatureDesc{};
+    rootSignatureDesc.spacesCount = spaces.size();
+    rootSignatureDesc.spacesDescs = spaces.data();
+    rootSignatureDesc.debugName = "SCARStatsRootSignature";
+    RHINO::RootSignature* rootSignature = rhi->SerializeRootSignature(rootSignatureDesc);
+
+    int status = 0;
+    for (const std::filesystem::path& filepath : archiveFilepaths) {
+        std::vector<uint8_t> archive{};
+        if (!ReadArchive(filepath, archive)) {
+            std::cerr << "Failed to read file: " << filepath << std::endl;
+            status = 1;
+            continue;
+        }
+
+        const std::string name = filepath.filename().string();
+        RHINO::ComputePSO* pso = rhi->CompileSCARComputePSO(archive.data(), static_cast<uint32_t>(archive.size()), rootSignature,
+                                                            name.c_str());
+        if (!pso) {
+            std::cerr << "Failed to create PSO: " << filepath << std::endl;
+            status = 1;
+            continue;
+        }
+
+        auto stats = std::make_unique<RHINO::PSOStatistics>();
+        std::cout << name << ":" << std::endl;
+        if (pso->GetStatistics(stats.get())) {
+            PrintStatistics(*stats);
+        } else {
+            std::cout << "  Statistics are not supported by driver." << std::endl;
+        }
+        pso->Release();
+    }
+
+    rootSignature->Release();
+    rhi->Release();
+    delete rhi;
+    return status;
+}
@@ -27,6 +27,8 @@ namespace SCAR {
     struct ComputeCompileSettings {
         const char* inputFilepath = nullptr;
         const char* entrypoint = nullptr;
+        // Compile with shader model 6.5 to allow inline ray tracing (RayQuery).
+        bool inlineRayTracing = false;
     };
 
     struct LibraryCompileSettings {
@@ -47,6 +47,16 @@ namespace SCAR {
         // Configuration payload
         ShadersEntrypoints,
         RTAttributes,
+        SpecializationConstants,
+        WorkgroupSize,
+    };
+
+    /**
+     * Item of SpecializationConstants record. Value is raw 32 bit default value of the constant declared in shader.
+     */
+    struct SpecializationConstantItem {
+        uint32_t constantID = 0;
+        uint32_t defaultValue = 0;
     };
 
     struct Record {
@@ -82,6 +92,8 @@ namespace SCAR {
                     case RecordType::LibAssembly:
                     case RecordType::ShadersEntrypoints:
                     case RecordType::RTAttributes:
+                    case RecordType::SpecializationConstants:
+                    case RecordType::WorkgroupSize:
                         record.flags = *ReadItem<RecordFlags>(cursor);
                         record.data = m_Archive + *ReadItem<uint32_t>(cursor);
                         record.dataSize = *ReadItem<uint32_t>(cursor);
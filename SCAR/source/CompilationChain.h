@@ -7,6 +7,9 @@ namespace SCAR {
 
         size_t dataLength = 0;
         std::unique_ptr<uint8_t> data;
+
+        // Compute shader [numthreads]. Zero if not reflected.
+        uint32_t workgroupSize[3] = {};
     };
 
     enum class ChainStageTarget {
@@ -23,6 +26,7 @@ namespace SCAR {
         std::filesystem::path shaderFilepath;
         std::optional<std::string> entrypoint;
         std::set<std::string> defines;
+        bool inlineRayTracing = false;
     };
 
     class CompilationChain {
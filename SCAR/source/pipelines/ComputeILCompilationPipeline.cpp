@@ -15,6 +15,7 @@ namespace SCAR {
         chSettings.shaderFilepath = settings.computeSettings.inputFilepath;
         chSettings.entrypoint = settings.computeSettings.entrypoint;
         chSettings.stage = ChainStageTarget::Compute;
+        chSettings.inlineRayTracing = settings.computeSettings.inlineRayTracing;
 
         ChainContext context{};
         bool status = m_CompilationChain->Run(settings, chSettings, context);
@@ -30,6 +31,21 @@ namespace SCAR {
 
         PSOArchiver archiver{settings.psoType, settings.psoLang};
         archiver.AddRecord(RecordType::CSAssembly, RecordFlags::None, shaderModuleAssembly, context.dataLength);
+        if (settings.psoLang == ArchivePSOLang::SPIRV) {
+            std::vector<std::string> constantsErrors{};
+            std::vector<uint8_t> constants = SerializeSpecializationConstants(shaderModuleAssembly, context.dataLength, constantsErrors);
+            if (!constantsErrors.empty()) {
+                errors.insert(errors.end(), constantsErrors.cbegin(), constantsErrors.cend());
+                delete shaderModuleAssembly;
+                return {nullptr, 0};
+            }
+            if (!constants.empty()) {
+                archiver.AddRecord(RecordType::SpecializationConstants, RecordFlags::MultipleValues, constants);
+            }
+        }
+        if (context.workgroupSize[0] != 0) {
+            archiver.AddRecord(RecordType::WorkgroupSize, RecordFlags::None, context.workgroupSize, sizeof(context.workgroupSize));
+        }
         delete shaderModuleAssembly;
         archiver.AddRecord(RecordType::ShadersEntrypoints, RecordFlags::None, SerializeEntrypoints({settings.computeSettings.entrypoint}));
         return archiver.Archive();
@@ -0,0 +1,75 @@
+#include "Serializers.h"
+
+namespace SCAR {
+    // SPIR-V opcodes and decorations used for specialization constants reflection.
+    static constexpr uint32_t SPIRV_MAGIC = 0x07230203;
+    static constexpr uint32_t SPIRV_HEADER_WORDS = 5;
+    static constexpr uint16_t SPIRV_OP_DECORATE = 71;
+    static constexpr uint16_t SPIRV_OP_SPEC_CONSTANT_TRUE = 48;
+    static constexpr uint16_t SPIRV_OP_SPEC_CONSTANT_FALSE = 49;
+    static constexpr uint16_t SPIRV_OP_SPEC_CONSTANT = 50;
+    static constexpr uint32_t SPIRV_DECORATION_SPEC_ID = 1;
+
+    std::vector<uint8_t> SerializeSpecializationConstants(const uint8_t* spirvAssembly, size_t sizeInBytes,
+                                                          std::vector<std::string>& errors) noexcept {
+        const size_t wordsCount = sizeInBytes / sizeof(uint32_t);
+        std::vector<uint32_t> words(wordsCount);
+        memcpy(words.data(), spirvAssembly, wordsCount * sizeof(uint32_t));
+        if (wordsCount < SPIRV_HEADER_WORDS || words[0] != SPIRV_MAGIC) {
+            return {};
+        }
+
+        // SpecId decorations are declared before constants, so ids are resolved in single pass.
+        std::map<uint32_t, uint32_t> specIDs{};
+        std::map<uint32_t, uint32_t> defaults{};
+        for (size_t cursor = SPIRV_HEADER_WORDS; cursor < wordsCount;) {
+            const auto opcode = static_cast<uint16_t>(words[cursor] & 0xFFFF);
+            const auto instructionWords = static_cast<uint16_t>(words[cursor] >> 16);
+            if (instructionWords == 0 || cursor + instructionWords > wordsCount) {
+                break;
+            }
+            const uint32_t* operands = words.data() + cursor + 1;
+
+            switch (opcode) {
+                case SPIRV_OP_DECORATE:
+                    if (instructionWords >= 4 && operands[1] == SPIRV_DECORATION_SPEC_ID) {
+                        specIDs[operands[0]] = operands[2];
+                    }
+                    break;
+                case SPIRV_OP_SPEC_CONSTANT_TRUE:
+                case SPIRV_OP_SPEC_CONSTANT_FALSE:
+                    if (specIDs.contains(operands[1])) {
+                        defaults[specIDs[operands[1]]] = opcode == SPIRV_OP_SPEC_CONSTANT_TRUE ? 1 : 0;
+                    }
+                    break;
+                case SPIRV_OP_SPEC_CONSTANT:
+                    if (instructionWords < 4 || !specIDs.contains(operands[1])) {
+                        break;
+                    }
+                    // Value takes more than one word for 64 bit types. Runtime constants are 32 bit.
+                    if (instructionWords > 4) {
+                        errors.emplace_back("Specialization constant " + std::to_string(specIDs[operands[1]]) +
+                                            " is 64 bit. Only 32 bit specialization constants are supported.");
+                        break;
+                    }
+                    defaults[specIDs[operands[1]]] = operands[2];
+                    break;
+                default:
+                    break;
+            }
+            cursor += instructionWords;
+        }
+        if (!errors.empty()) {
+            return {};
+        }
+
+        std::vector<uint8_t> result(defaults.size() * sizeof(SpecializationConstantItem));
+        size_t offset = 0;
+        for (const auto& [constantID, defaultValue] : defaults) {
+            const SpecializationConstantItem item{constantID, defaultValue};
+            memcpy(result.data() + offset, &item, sizeof(SpecializationConstantItem));
+            offset += sizeof(SpecializationConstantItem);
+        }
+        return result;
+    }
+}
@@ -4,4 +4,8 @@
 
 namespace SCAR {
     std::vector<uint8_t> SerializeEntrypoints(const std::vector<std::string>& entrypoints) noexcept;
+    // Reflects SpecId decorated constants from SPIR-V module. Returns empty data for non SPIR-V modules.
+    // Only 32 bit constants are supported, 64 bit ones are reported to errors.
+    std::vector<uint8_t> SerializeSpecializationConstants(const uint8_t* spirvAssembly, size_t sizeInBytes,
+                                                          std::vector<std::string>& errors) noexcept;
 }
\ No newline at end of file
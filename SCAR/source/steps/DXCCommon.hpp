@@ -59,7 +59,7 @@ namespace SCAR {
                 args.emplace_back(L"ps_6_0");
                 break;
             case ChainStageTarget::Compute:
-                args.emplace_back(L"cs_6_0");
+                args.emplace_back(chSettings.inlineRayTracing ? L"cs_6_5" : L"cs_6_0");
                 break;
             case ChainStageTarget::Lib:
                 args.emplace_back(L"lib_6_3");
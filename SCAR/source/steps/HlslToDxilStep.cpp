@@ -2,8 +2,58 @@
 
 
 #include "DXCCommon.hpp"
+#ifdef WIN32
+#include <d3d12shader.h>
+#endif // WIN32
 
 namespace SCAR {
+#ifndef WIN32
+    // Reads [numthreads] from PSV0 part of DXIL container. PSVRuntimeInfo2 and newer carry NumThreads.
+    static bool ReflectWorkgroupSize(const uint8_t* container, size_t sizeInBytes, uint32_t outWorkgroupSize[3]) noexcept {
+        constexpr uint32_t DXIL_FOURCC_CONTAINER = 0x43425844; // DXBC
+        constexpr uint32_t DXIL_FOURCC_PSV0 = 0x30565350;      // PSV0
+        constexpr size_t CONTAINER_HEADER_SIZE = 32;           // FourCC, digest[16], version, container size, parts count.
+        constexpr size_t PART_HEADER_SIZE = 8;                 // FourCC, part size.
+        constexpr size_t PSV_RUNTIME_INFO_2_SIZE = 48;
+        constexpr size_t PSV_NUM_THREADS_OFFSET = 36;
+
+        auto readU32 = [container](size_t offset) noexcept {
+            uint32_t value = 0;
+            memcpy(&value, container + offset, sizeof(uint32_t));
+            return value;
+        };
+
+        if (sizeInBytes < CONTAINER_HEADER_SIZE || readU32(0) != DXIL_FOURCC_CONTAINER) {
+            return false;
+        }
+        const uint32_t partsCount = readU32(28);
+        if ((sizeInBytes - CONTAINER_HEADER_SIZE) / sizeof(uint32_t) < partsCount) {
+            return false;
+        }
+        for (uint32_t i = 0; i < partsCount; ++i) {
+            const size_t partOffset = readU32(CONTAINER_HEADER_SIZE + i * sizeof(uint32_t));
+            if (partOffset > sizeInBytes - PART_HEADER_SIZE || readU32(partOffset) != DXIL_FOURCC_PSV0) {
+                continue;
+            }
+            const size_t partSize = readU32(partOffset + 4);
+            const size_t partData = partOffset + PART_HEADER_SIZE;
+            if (partSize < sizeof(uint32_t) || partSize > sizeInBytes - partData) {
+                return false;
+            }
+            const size_t runtimeInfoSize = readU32(partData);
+            if (runtimeInfoSize < PSV_RUNTIME_INFO_2_SIZE || runtimeInfoSize > partSize - sizeof(uint32_t)) {
+                return false;
+            }
+            const size_t numThreads = partData + sizeof(uint32_t) + PSV_NUM_THREADS_OFFSET;
+            for (size_t axis = 0; axis < 3; ++axis) {
+                outWorkgroupSize[axis] = readU32(numThreads + axis * sizeof(uint32_t));
+            }
+            return true;
+        }
+        return false;
+    }
+#endif // WIN32
+
     bool HlslToDxilStep::Execute(const CompileSettings& settings, const ChainSettings& chSettings,
                                  ChainContext& context) noexcept {
         std::ifstream shaderStream{chSettings.shaderFilepath};
@@ -74,6 +124,28 @@ namespace SCAR {
         context.dataLength = outObject->GetBufferSize();
         context.data.reset(new uint8_t[context.dataLength]);
         memcpy(context.data.get(), outObject->GetBufferPointer(), context.dataLength * sizeof(uint8_t));
+
+#ifdef WIN32
+        IDxcBlob* reflectionBlob{};
+        if (chSettings.stage == ChainStageTarget::Compute && result->HasOutput(DXC_OUT_REFLECTION) &&
+            SUCCEEDED(result->GetOutput(DXC_OUT_REFLECTION, IID_PPV_ARGS(&reflectionBlob), nullptr))) {
+            DxcBuffer reflectionBuffer{};
+            reflectionBuffer.Ptr = reflectionBlob->GetBufferPointer();
+            reflectionBuffer.Size = reflectionBlob->GetBufferSize();
+            ID3D12ShaderReflection* shaderReflection{};
+            if (SUCCEEDED(dxcUtils->CreateReflection(&reflectionBuffer, IID_PPV_ARGS(&shaderReflection)))) {
+                shaderReflection->GetThreadGroupSize(&context.workgroupSize[0], &context.workgroupSize[1], &context.workgroupSize[2]);
+                shaderReflection->Release();
+            }
+            reflectionBlob->Release();
+        }
+#else
+        // d3d12shader.h is not shipped with DXC for this platform, container is parsed directly.
+        if (chSettings.stage == ChainStageTarget::Compute &&
+            !ReflectWorkgroupSize(context.data.get(), context.dataLength, context.workgroupSize)) {
+            context.warnings.emplace_back("Failed to reflect workgroup size: DXIL container has no PSV0 runtime info of version 2 or newer.");
+        }
+#endif // WIN32
         return true;
     }
 } // namespace SCAR
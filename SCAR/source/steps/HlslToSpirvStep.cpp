@@ -4,6 +4,29 @@
 #include "DXCCommon.hpp"
 
 namespace SCAR {
+    // Reads OpExecutionMode LocalSize. LocalSizeId modes are not resolved.
+    static void ReflectWorkgroupSize(const uint8_t* spirv, size_t sizeInBytes, uint32_t outWorkgroupSize[3]) noexcept {
+        constexpr uint32_t SPIRV_HEADER_WORDS = 5;
+        constexpr uint16_t SPIRV_OP_EXECUTION_MODE = 16;
+        constexpr uint32_t SPIRV_EXECUTION_MODE_LOCAL_SIZE = 17;
+
+        const size_t wordsCount = sizeInBytes / sizeof(uint32_t);
+        std::vector<uint32_t> words(wordsCount);
+        memcpy(words.data(), spirv, wordsCount * sizeof(uint32_t));
+        for (size_t cursor = SPIRV_HEADER_WORDS; cursor < wordsCount;) {
+            const auto opcode = static_cast<uint16_t>(words[cursor] & 0xFFFF);
+            const auto instructionWords = static_cast<uint16_t>(words[cursor] >> 16);
+            if (instructionWords == 0 || cursor + instructionWords > wordsCount) {
+                return;
+            }
+            if (opcode == SPIRV_OP_EXECUTION_MODE && instructionWords >= 6 && words[cursor + 2] == SPIRV_EXECUTION_MODE_LOCAL_SIZE) {
+                memcpy(outWorkgroupSize, &words[cursor + 3], 3 * sizeof(uint32_t));
+                return;
+            }
+            cursor += instructionWords;
+        }
+    }
+
     bool HlslToSpirvStep::Execute(const CompileSettings& settings, const ChainSettings& chSettings,
                                   ChainContext& context) noexcept {
         std::ifstream shaderStream{chSettings.shaderFilepath};
@@ -76,6 +99,10 @@ namespace SCAR {
         context.dataLength = outObject->GetBufferSize();
         context.data.reset(new uint8_t[context.dataLength]);
         memcpy(context.data.get(), outObject->GetBufferPointer(), context.dataLength * sizeof(uint8_t));
+
+        if (chSettings.stage == ChainStageTarget::Compute) {
+            ReflectWorkgroupSize(context.data.get(), context.dataLength, context.workgroupSize);
+        }
         return true;
     }
 } // namespace SCAR